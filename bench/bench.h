@@ -0,0 +1,26 @@
+///////////////////////////////////////////////////////////////////
+// Bench
+// Timing and the common CSV output of the benchmarks of make bench
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdio.h>
+#include <time.h>
+
+// Every benchmark writes one line per measurement: the benchmark, what is measured(a structure, or a load of the
+// simulator), the operation, its size, the number of operations, their total time and the time per operation
+#define BENCH_HEADER "bench,subject,operation,n,ops,seconds,ns_per_op,ops_per_sec"
+
+#define BENCH_MIN_OPS 1000000	// the small sizes are repeated till they have at least that many operations
+
+static inline double bench_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline void bench_report(const char* bench, const char* subject, const char* operation, long n, long ops, double seconds) {
+	printf("%s,%s,%s,%ld,%ld,%.6f,%.2f,%.0f\n", bench, subject, operation, n, ops, seconds,
+		   ops ? seconds * 1e9 / ops : 0.0, seconds > 0 ? ops / seconds : 0.0);
+}
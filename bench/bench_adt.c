@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////
+// Microbenchmarks of the Vector and the PriorityQueue,
+// written as CSV(BENCH_HEADER) to track them between versions
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ADTVector.h"
+#include "ADTPriorityQueue.h"
+#include "bench.h"
+
+// the keys of the pqueue, random ints
+static int int_compare(void* a, void* b) { return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b); }
+
+static volatile long sink;	// the values read are stored here, so that the reads aren't optimized away
+
+// n elements inserted at the end, read and replaced at random positions, removed from the end till the vector
+// is empty, and then resized: drained to n/8 and filled back to n, so that it shrinks and grows again every time
+static void bench_vector(int* keys, int* positions, int n, int rounds) {
+	double insert = 0, get = 0, set = 0, remove = 0, resize = 0;
+	long sum = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		Vector* vec = vector_create(0, NULL);
+
+		double start = bench_now();
+		for (int i = 0; i < n; i++)
+			vector_insert_last(vec, &keys[i]);
+		insert += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++)
+			sum += *(int*)vector_get_at(vec, positions[i]);
+		get += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++)
+			vector_set_at(vec, positions[i], &keys[i]);
+		set += bench_now() - start;
+
+		start = bench_now();
+		for (int cycle = 0; cycle < 4; cycle++) {
+			while (vector_size(vec) > n / 8)
+				vector_remove_last(vec);
+			while (vector_size(vec) < n)
+				vector_insert_last(vec, &keys[vector_size(vec)]);
+		}
+		resize += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++)
+			vector_remove_last(vec);
+		remove += bench_now() - start;
+
+		vector_destroy(vec);
+	}
+
+	long ops = (long)n * rounds;
+	bench_report("adt", "vector", "insert_last", n, ops, insert);
+	bench_report("adt", "vector", "get_at", n, ops, get);
+	bench_report("adt", "vector", "set_at", n, ops, set);
+	bench_report("adt", "vector", "remove_last", n, ops, remove);
+	bench_report("adt", "vector", "resize", n, 4 * 2 * (n - n / 8) * (long)rounds, resize);
+	sink = sum;
+}
+
+// n elements inserted one by one, every other one removed from any position, and the rest removed as max.
+// And n elements heapified at once, from a vector
+static void bench_pqueue(int* keys, int n, int rounds) {
+	double insert = 0, remove_node = 0, remove_max = 0, heapify = 0;
+	PriorityQueueNode** nodes = malloc(n * sizeof(*nodes));
+	Vector* values = vector_create(0, NULL);
+	for (int i = 0; i < n; i++)
+		vector_insert_last(values, &keys[i]);
+
+	for (int r = 0; r < rounds; r++) {
+		PriorityQueue* pq = pqueue_create(int_compare, NULL, NULL, 0);
+
+		double start = bench_now();
+		for (int i = 0; i < n; i++)
+			nodes[i] = pqueue_insert(pq, &keys[i]);
+		insert += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i += 2)
+			pqueue_remove_node(pq, nodes[i]);
+		remove_node += bench_now() - start;
+
+		start = bench_now();
+		while (pqueue_size(pq) != 0)
+			pqueue_remove_max(pq);
+		remove_max += bench_now() - start;
+
+		pqueue_destroy(pq);
+
+		start = bench_now();
+		pq = pqueue_create(int_compare, NULL, values, 0);
+		heapify += bench_now() - start;
+		pqueue_destroy(pq);
+	}
+
+	long ops = (long)n * rounds;
+	bench_report("adt", "pqueue", "insert", n, ops, insert);
+	bench_report("adt", "pqueue", "remove_node", n, (long)(n + 1) / 2 * rounds, remove_node);
+	bench_report("adt", "pqueue", "remove_max", n, (long)n / 2 * rounds, remove_max);
+	bench_report("adt", "pqueue", "heapify", n, ops, heapify);
+
+	vector_destroy(values);
+	free(nodes);
+}
+
+int main(int argc, char* argv[]) {
+	int max_n = argc > 1 ? atoi(argv[1]) : 10000000;
+	srand(1);
+
+	printf("%s\n", BENCH_HEADER);
+	for (int n = 1000; n <= max_n; n *= 10) {
+		int* keys = malloc(n * sizeof(*keys));
+		int* positions = malloc(n * sizeof(*positions));
+		for (int i = 0; i < n; i++) {
+			keys[i] = rand();
+			positions[i] = rand() % n;
+		}
+
+		// the small sizes are repeated, so that every measurement is long enough
+		int rounds = n < BENCH_MIN_OPS ? BENCH_MIN_OPS / n : 1;
+		bench_vector(keys, positions, n, rounds);
+		bench_pqueue(keys, n, rounds);
+
+		free(positions);
+		free(keys);
+	}
+	return 0;
+}
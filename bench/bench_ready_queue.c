@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////
+// Benchmark of the ReadyHeap and the MultilevelQueue against
+// the generic PriorityQueue, used as a ready queue of processes,
+// written as CSV(BENCH_HEADER) like the other benchmarks
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ADTPriorityQueue.h"
+#include "ADTReadyHeap.h"
+#include "ADTMultilevelQueue.h"
+#include "bench.h"
+
+// the keys of a ready process
+typedef struct bench_process {
+	int priority;
+	int pid;
+	double arrival_time;
+	PriorityQueueNode* node;
+	int handle;
+} BenchProcess;
+
+// same order as ready_pq_compare
+static int bench_compare(void* a, void* b) {
+	BenchProcess* pa = a, *pb = b;
+	if (pa->priority != pb->priority)
+		return pb->priority - pa->priority;
+	if (pa->arrival_time != pb->arrival_time)
+		return pa->arrival_time < pb->arrival_time ? 1 : -1;
+	return pb->pid - pa->pid;
+}
+
+// the total times of the operations of an implementation, in all the rounds
+static void report(const char* impl, int n, int rounds, double insert, double preemption, double remove_node, double remove_max) {
+	long ops = (long)n * rounds;
+	bench_report("ready_queue", impl, "insert", n, ops, insert);
+	bench_report("ready_queue", impl, "preemption", n, ops, preemption);
+	bench_report("ready_queue", impl, "remove_node", n, (long)(n + 1) / 2 * rounds, remove_node);
+	bench_report("ready_queue", impl, "remove_max", n, (long)n / 2 * rounds, remove_max);
+}
+
+// n processes inserted, n preemptions(remove_max + insert), n/2 arbitrary removals, and the rest removed as max
+static void bench_pqueue(BenchProcess* procs, int n, int rounds) {
+	double insert = 0, preemption = 0, remove_node = 0, remove_max = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		PriorityQueue* pq = pqueue_create(bench_compare, NULL, NULL, 0);
+
+		double start = bench_now();
+		for (int i = 0; i < n; i++)
+			procs[i].node = pqueue_insert(pq, &procs[i]);
+		insert += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++) {
+			BenchProcess* proc = pqueue_remove_max(pq);
+			proc->node = pqueue_insert(pq, proc);
+		}
+		preemption += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i += 2)
+			pqueue_remove_node(pq, procs[i].node);
+		remove_node += bench_now() - start;
+
+		start = bench_now();
+		while (pqueue_size(pq) != 0)
+			pqueue_remove_max(pq);
+		remove_max += bench_now() - start;
+
+		pqueue_destroy(pq);
+	}
+	report("pqueue", n, rounds, insert, preemption, remove_node, remove_max);
+}
+
+static void bench_ready_heap(BenchProcess* procs, int n, int rounds) {
+	double insert = 0, preemption = 0, remove_node = 0, remove_max = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		ReadyHeap* heap = ready_heap_create(0);
+
+		double start = bench_now();
+		for (int i = 0; i < n; i++)
+			procs[i].handle = ready_heap_insert(heap, procs[i].priority, procs[i].arrival_time, procs[i].pid, &procs[i]);
+		insert += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++) {
+			BenchProcess* proc = ready_heap_remove_max(heap);
+			proc->handle = ready_heap_insert(heap, proc->priority, proc->arrival_time, proc->pid, proc);
+		}
+		preemption += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i += 2)
+			ready_heap_remove(heap, procs[i].handle);
+		remove_node += bench_now() - start;
+
+		start = bench_now();
+		while (ready_heap_size(heap) != 0)
+			ready_heap_remove_max(heap);
+		remove_max += bench_now() - start;
+
+		ready_heap_destroy(heap);
+	}
+	report("heap", n, rounds, insert, preemption, remove_node, remove_max);
+}
+
+static void bench_multilevel(BenchProcess* procs, int n, int rounds) {
+	double insert = 0, preemption = 0, remove_node = 0, remove_max = 0;
+
+	for (int r = 0; r < rounds; r++) {
+		MultilevelQueue* queue = multilevel_create(7, 0);
+
+		double start = bench_now();
+		for (int i = 0; i < n; i++)
+			procs[i].handle = multilevel_insert(queue, procs[i].priority, procs[i].arrival_time, procs[i].pid, &procs[i]);
+		insert += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i++) {
+			BenchProcess* proc = multilevel_remove_max(queue);
+			proc->handle = multilevel_insert(queue, proc->priority, proc->arrival_time, proc->pid, proc);
+		}
+		preemption += bench_now() - start;
+
+		start = bench_now();
+		for (int i = 0; i < n; i += 2)
+			multilevel_remove(queue, procs[i].handle);
+		remove_node += bench_now() - start;
+
+		start = bench_now();
+		while (multilevel_size(queue) != 0)
+			multilevel_remove_max(queue);
+		remove_max += bench_now() - start;
+
+		multilevel_destroy(queue);
+	}
+	report("multilevel", n, rounds, insert, preemption, remove_node, remove_max);
+}
+
+int main(int argc, char* argv[]) {
+	int max_n = argc > 1 ? atoi(argv[1]) : 1000000;
+	srand(1);
+
+	printf("%s\n", BENCH_HEADER);
+	for (int n = 1000; n <= max_n; n *= 10) {
+		// processes with the priorities and arrivals of the simulator
+		BenchProcess* procs = malloc(n * sizeof(*procs));
+		double time = 0;
+		for (int i = 0; i < n; i++) {
+			procs[i].pid = i;
+			procs[i].priority = rand() % 7 + 1;
+			time += rand() / (RAND_MAX + 1.0);
+			procs[i].arrival_time = time;
+		}
+
+		// the small sizes are repeated, so that every measurement is long enough
+		int rounds = n < BENCH_MIN_OPS ? BENCH_MIN_OPS / n : 1;
+		bench_pqueue(procs, n, rounds);
+		bench_ready_heap(procs, n, rounds);
+		bench_multilevel(procs, n, rounds);
+		free(procs);
+	}
+	return 0;
+}
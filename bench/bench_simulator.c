@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////
+// End to end benchmark of the simulator: the time slots and
+// the processes simulated per second, at several loads
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "simulation.h"
+#include "bench.h"
+
+// A load of the simulator, its parameters except total_processes
+typedef struct bench_load {
+	const char* name;
+	double lambda_arrival;
+	double lambda_lifetime;
+	double lambda_cs_time;
+	int k;
+	int S;
+} BenchLoad;
+
+// Every process is alive for 1/lambda_lifetime time slots on average, and one arrives every 1/lambda_arrival,
+// so lambda_arrival/lambda_lifetime processes are alive at the same time on average: 0.5, 5, 20 and 200
+static BenchLoad loads[] = {
+	{"light", 0.1, 0.2, 0.5, 30, 3},
+	{"medium", 0.5, 0.1, 0.2, 30, 3},
+	{"heavy", 1, 0.05, 0.1, 40, 3},
+	{"overload", 2, 0.01, 0.1, 50, 2},
+};
+
+// The same seed every time, so that every version simulates the same processes
+#define BENCH_SEED 1
+
+// Runs a simulation of load with total processes, and reports its slots and processes per second
+static void bench_load(BenchLoad* load, int total, const char* mode, int cpus, bool event_driven) {
+	SimulationParams params = { .lambda_arrival = load->lambda_arrival, .lambda_lifetime = load->lambda_lifetime, .lambda_cs_time = load->lambda_cs_time,
+								.total_processes = total, .workload = NULL, .k = load->k, .S = load->S, .sem_count = 1, .sem_queues = false,
+								.sem_protocol = SEM_PROTOCOL_NONE, .cpus = cpus, .event_driven = event_driven, .ready_queue_type = READY_PQUEUE };
+	SimulationStats stats;
+	stats.busy_slots = malloc(cpus * sizeof(*stats.busy_slots));
+	Rng rng;
+	rng_seed(&rng, BENCH_SEED);
+
+	double start = bench_now();
+	simulate(&params, &rng, NULL, NULL, &stats);
+	double seconds = bench_now() - start;
+
+	long finished = 0;
+	for (int p = 0; p < PRIORITIES; p++)
+		finished += stats.turnaround[p].count;
+
+	char subject[64];
+	snprintf(subject, sizeof(subject), "%s %s", load->name, mode);
+	bench_report("simulator", subject, "slots", total, stats.total_slots, seconds);
+	bench_report("simulator", subject, "processes", total, finished, seconds);
+	free(stats.busy_slots);
+}
+
+int main(int argc, char* argv[]) {
+	int total = argc > 1 ? atoi(argv[1]) : 100000;
+
+	printf("%s\n", BENCH_HEADER);
+	for (size_t i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+		bench_load(&loads[i], total, "slotted", 1, false);
+		bench_load(&loads[i], total, "event-driven", 1, true);
+		bench_load(&loads[i], total, "4 cpus", 4, false);
+	}
+	return 0;
+}
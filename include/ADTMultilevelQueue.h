@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////
+// ADT Multilevel Queue
+// Ready queue with one list per priority level, sorted by arrival
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#define MULTILEVEL_MAX_LEVELS 64	// one bit of the bitmap of non-empty levels per level
+
+// The multilevel queue is implemented using a struct MultilevelQueue
+// Priorities are 1..levels, and 1 is the highest one. Every level is ordered by arrival_time and then by pid,
+// so the max element is the same as the one of ready_pq_compare. So the levels aren't strict FIFOs: an element
+// is linked at its sorted position, found by scanning its level backwards from the last element.
+// remove_max, remove and max are O(1). insert and update_priority are O(1) for an element that goes to the end
+// or the start of its level(an arriving process, or a preempted one that arrived before all the others), and
+// O(m) in the worst case, for the m elements of its level that arrived after it(e.g. a process woken from a
+// semaphore wait queue, or moved to another level by --sem-protocol, among processes that arrived later)
+typedef struct multilevel_queue MultilevelQueue;
+
+// Creates and returns an empty multilevel queue with the given levels, with space for capacity elements before it has to grow
+MultilevelQueue* multilevel_create(int levels, int capacity);
+
+// Multilevel queue size
+int multilevel_size(MultilevelQueue* queue);
+
+// Value of the maximum element, the first one of the highest priority non-empty level
+void* multilevel_max(MultilevelQueue* queue);
+
+// Inserts value with the given keys and returns a handle of it, which can be used for its removal
+// The handle stays valid until the element is removed
+int multilevel_insert(MultilevelQueue* queue, int priority, double arrival_time, int pid, void* value);
+
+// The element with that handle moves to the level of priority, to its position by its arrival_time and pid. Its handle stays the same
+void multilevel_update_priority(MultilevelQueue* queue, int handle, int priority);
+
+// Removes the maximum element and returns its value
+void* multilevel_remove_max(MultilevelQueue* queue);
+
+// Removes the element with that handle, from any position of its level
+void multilevel_remove(MultilevelQueue* queue, int handle);
+
+// Deallocates the memory used by queue
+void multilevel_destroy(MultilevelQueue* queue);
@@ -14,7 +14,9 @@ typedef struct priority_queue_node PriorityQueueNode;
 // Creates and returns a PQ, with the elements' order being according to the compare function given
 // If destroy_value != NULL then destroy_value(value) is called everytime an element is removed
 // If values != NULL, the PQ is initialized with the elements of the Vector values
-PriorityQueue* pqueue_create(CompareFunc compare, DestroyFunc destroy_value, Vector* values);
+// The PQ has memory for capacity elements(or the size of values, if it's bigger) from the start, so it's reallocated only
+// if it gets bigger than that. It's never shrunk, like its pool of nodes
+PriorityQueue* pqueue_create(CompareFunc compare, DestroyFunc destroy_value, Vector* values, int capacity);
 
 // PQ size
 int pqueue_size(PriorityQueue* pqueue);
@@ -23,6 +25,8 @@ int pqueue_size(PriorityQueue* pqueue);
 void* pqueue_max(PriorityQueue* pqueue);
 
 // Element with the given value is inserted to the PQ
+// The nodes come from a pool owned by the PQ, so once it has grown to its steady size, no memory is allocated.
+// The node returned stays valid until its element is removed
 PriorityQueueNode* pqueue_insert(PriorityQueue* pqueue, void* value);
 
 // Removes the maximum(according to compare function given) element of the PQ and returns it
@@ -39,12 +43,23 @@ void pqueue_destroy(PriorityQueue* pqueue);
 void* pqueue_node_value(PriorityQueueNode* node);
 
 // Removes the node, which can be in any position of the pqueue
-// !! It's mandatory that we call pqueue_update_order() after
+// The heap property is restored from the position of the removed node, in O(logn)
 void pqueue_remove_node(PriorityQueue* pqueue, PriorityQueueNode* node);
 
-// Updates the pqueue, after a change in the order of the pqueue because of the removal of node.
+// Updates the pqueue, after a change in the order of the pqueue because of a change in the value of node.
+// The node can have become either greater or smaller
 void pqueue_update_order(PriorityQueue* pqueue, PriorityQueueNode* node);
 
+// Updates the pqueue after the value of node became greater(according to compare function given), in O(logn)
+void pqueue_increase_key(PriorityQueue* pqueue, PriorityQueueNode* node);
+
+// Updates the pqueue after the value of node became smaller(according to compare function given), in O(logn)
+void pqueue_decrease_key(PriorityQueue* pqueue, PriorityQueueNode* node);
+
+// Returns true if every node satisfies the heap property and knows its position in the pqueue
+// If compiled with -DPQUEUE_CHECK_INVARIANT, it's asserted after every operation that changes the pqueue
+bool pqueue_check_invariant(PriorityQueue* pqueue);
+
 // function for handling the processes in the pq
 Vector* pqueue_get_vector(PriorityQueue* pq);
 
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////
+// ADT Ready Heap
+// Priority queue specialized for the ready processes
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+// The ready heap is implemented using a struct ReadyHeap
+// The keys (priority, arrival_time, pid) are stored inline, next to the value, so that comparisons don't
+// go through any pointer. The max element is the one with the smallest priority number, then with the
+// smallest arrival_time and then with the smallest pid (the order of ready_pq_compare)
+typedef struct ready_heap ReadyHeap;
+
+// Creates and returns an empty ready heap, with space for capacity elements before it has to grow
+ReadyHeap* ready_heap_create(int capacity);
+
+// Ready heap size
+int ready_heap_size(ReadyHeap* heap);
+
+// Value of the maximum element
+void* ready_heap_max(ReadyHeap* heap);
+
+// Inserts value with the given keys and returns a handle of it, which can be used for its removal
+// The handle stays valid until the element is removed
+int ready_heap_insert(ReadyHeap* heap, int priority, double arrival_time, int pid, void* value);
+
+// The priority of the element with that handle changes, and it moves to its new position. Its handle stays the same
+void ready_heap_update_priority(ReadyHeap* heap, int handle, int priority);
+
+// Removes the maximum element and returns its value
+void* ready_heap_remove_max(ReadyHeap* heap);
+
+// Removes the element with that handle, which can be in any position of the heap
+void ready_heap_remove(ReadyHeap* heap, int handle);
+
+// Deallocates the memory used by heap
+void ready_heap_destroy(ReadyHeap* heap);
@@ -9,6 +9,11 @@
 
 #define VECTOR_FAIL	(Vector*)0
 
+// The array of a vector is halved by a removal when less than 1/VECTOR_DEFAULT_SHRINK of it is used,
+// unless it's changed with vector_set_shrink(). VECTOR_NO_SHRINK disables the shrinking
+#define VECTOR_DEFAULT_SHRINK	4
+#define VECTOR_NO_SHRINK		0
+
 // The vector is implemented using a struct Vector
 typedef struct vector Vector;
 
@@ -19,6 +24,20 @@ Vector* vector_create(int size, DestroyFunc destroy_value);
 // Size of vec
 int vector_size(Vector* vec);
 
+// Number of elements vec has memory for, so the inserts till then don't reallocate it
+int vector_capacity(Vector* vec);
+
+// vec gets memory for at least capacity elements, so that the inserts till then don't reallocate it,
+// and the removals never shrink it below that either
+void vector_reserve(Vector* vec, int capacity);
+
+// The memory of vec is reduced to its size, and the capacity of vector_reserve() isn't kept any more
+void vector_shrink_to_fit(Vector* vec);
+
+// The array of vec is halved by a removal when less than 1/shrink of it is used, or never if shrink is VECTOR_NO_SHRINK
+// shrink > 2, so that the halved array still has free space and the next inserts don't grow it back at once
+void vector_set_shrink(Vector* vec, int shrink);
+
 // Inserts element value at the end of the vec, size incremented by 1
 void vector_insert_last(Vector* vec, void* value);
 
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////
+// Aggregate
+// Streaming summary of a metric: count, sum, min, max and a histogram,
+// updated in O(1) per value without keeping the values
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdio.h>
+
+// The histogram is log-linear(HDR style): the values are counted in whole time slots, rounded down, every power of 2
+// is split into AGGREGATE_SUB_BUCKETS buckets of equal width, and the values below 2*AGGREGATE_SUB_BUCKETS have
+// a bucket each. So every bucket is narrower than 1/AGGREGATE_SUB_BUCKETS of its values, and the memory is fixed
+#define AGGREGATE_SUB_BITS		4
+#define AGGREGATE_SUB_BUCKETS	(1 << AGGREGATE_SUB_BITS)
+#define AGGREGATE_MAX_EXPONENT	31		// values up to 2^32 - 1, the last bucket has everything above too
+#define AGGREGATE_BUCKETS		((AGGREGATE_MAX_EXPONENT - AGGREGATE_SUB_BITS + 2) * AGGREGATE_SUB_BUCKETS)
+
+typedef struct aggregate {
+	long count;
+	double sum;
+	double min;		// 0 if count = 0
+	double max;
+	int buckets[AGGREGATE_BUCKETS];
+} Aggregate;
+
+// Initializes an empty aggregate
+void aggregate_init(Aggregate* aggregate);
+
+// Adds value(>= 0) to the aggregate
+void aggregate_add(Aggregate* aggregate, double value);
+
+// Mean of the values added, 0 if there are none
+double aggregate_mean(Aggregate* aggregate);
+
+// The value below or at which are percentile% of the values added, at the precision of the buckets
+// (the high bound of the bucket, but not more than the max). 0 if there are none
+double aggregate_percentile(Aggregate* aggregate, double percentile);
+
+// Bounds of the bucket, its values are [low, high)
+double aggregate_bucket_low(int bucket);
+double aggregate_bucket_high(int bucket);
+
+// Prints the non empty buckets of the aggregate in one line, "[low, high): count" each
+void aggregate_print_histogram(Aggregate* aggregate, FILE* out);
+
+// Writes the aggregate as a JSON object, with its count, mean, min, max, percentiles and non empty buckets
+void aggregate_write_json(Aggregate* aggregate, FILE* out);
+
+// Writes a CSV row for every non empty bucket, "<prefix>,low,high,count"
+void aggregate_write_csv(Aggregate* aggregate, const char* prefix, FILE* out);
@@ -0,0 +1,34 @@
+///////////////////////////////////////////////////////////////////
+// Arrival source
+// The processes of a simulation, produced one by one in arrival order,
+// only when they are about to arrive
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include "process_table.h"
+#include "rng.h"
+#include "workload.h"
+
+typedef struct arrival_source ArrivalSource;
+
+// Creates a source of total_processes processes, generated with exponential interarrival times, lifetimes and cs_times
+// and uniform priorities, from the random numbers of rng(its state is copied, rng isn't changed)
+ArrivalSource* arrival_source_create_generator(int total_processes, double lambda_arrival, double lambda_lifetime, double lambda_cs_time, Rng* rng);
+
+// Generates at once the processes that arrival_source_create_generator would give with the same parameters, into a workload
+// in memory, so that many simulations can replay the same processes without generating them again
+Workload* arrival_source_generate_workload(int total_processes, double lambda_arrival, double lambda_lifetime, double lambda_cs_time, Rng* rng);
+
+// Creates a source that replays the processes of the workload, in the order of the file
+// The workload isn't changed, and it must stay open till the source is destroyed
+ArrivalSource* arrival_source_create_replay(Workload* workload);
+
+// Returns the arrival_time of the next process of the source, or INFINITY if there are no more processes
+double arrival_source_peek(ArrivalSource* source);
+
+// Initializes proc as the next process of the source, which is removed from it. The source must not be empty
+void arrival_source_next(ArrivalSource* source, Process* proc);
+
+// Deallocates the memory of the source
+void arrival_source_destroy(ArrivalSource* source);
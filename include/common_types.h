@@ -1,5 +1,6 @@
 #pragma once // #include once
 #include <stdbool.h>
+#include "rng.h"
 #define error_exit(msg)		do { perror(msg); exit(EXIT_FAILURE); \
 							} while (false)
 
@@ -12,17 +13,16 @@ typedef int (*CompareFunc)(void* a, void* b);
 // Pointer to function that destroys the element value
 typedef void (*DestroyFunc)(void* value);
 
-// compare based first on arrival time, then on priority, and then on pid
-int process_pool_compare(void *a, void *b);
-
 // compare based first on priority, then on arrival time, and then on pid
 int ready_pq_compare(void *a, void *b);
 
-// compare based first on end_time, then on arrival time, and then on pid
-int finished_pq_compare(void *a, void *b);
+// compare based first on lifetime, and then on pid
+int expiry_pq_compare(void *a, void *b);
+
+// The random numbers are drawn from rng, so that every simulation has its own random state
 
 // exponential distribution
-double rand_exponential(double lambda);
+double rand_exponential(double lambda, Rng* rng);
 
 // uniform distribution
-int rand_uniform(int low, int high);
\ No newline at end of file
+int rand_uniform(int low, int high, Rng* rng);
\ No newline at end of file
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////
+// Process table
+// The records of the alive processes of a simulation, allocated in blocks and reused
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include "semaphore.h"
+#include "ADTPriorityQueue.h"
+#include "ready_queue.h"
+
+#define NOT_STARTED -1	// start_time of a process that hasn't got a cpu yet
+
+// The fields read on every scheduling decision and lifetime check are first, so that they share a cache line,
+// and the statistics and bookkeeping of the process follow
+typedef struct process {
+	// hot fields
+	int pid;
+	int priority;
+	int effective_priority;	// the priority it's scheduled with, raised above its own by the --sem-protocol while it holds a semaphore
+	double arrival_time;
+	double lifetime;
+	Semaphore sem_alloc;
+	int cs_time_executed;
+	int waiting_time;
+
+	// cold fields
+	double cs_time;
+	int cs_enter_probability;
+	int time_slots_running;
+	int start_time;		// NOT_STARTED till it gets a cpu, as a process can arrive and run at slot 0
+	int end_time;
+	int blocked_time;
+	int ready_since;	// time slot in which the process entered the ready_pq, its waiting_time is settled when it leaves
+	int blocked_since;	// time slot in which the process was blocked on its sem_alloc(--sem-queues), its blocked_time is settled when it's woken
+
+	int cpu;						// cpu whose ready_pq the process is in
+	ReadyHandle ready_handle;		// handle of the process in the ready_pq, for its removal
+	PriorityQueueNode* expiry_node;	// node of the process in the expiry_pq, which indexes the ready_pq and the blocked processes by lifetime
+	PriorityQueueNode* wait_node;	// node of the process in the wait queue of its sem_alloc, NULL if it isn't blocked on it
+} Process;
+
+// The processes alive in a simulation, the ones that have arrived and haven't passed their lifetime yet.
+// The records are allocated in blocks, every block twice the size of the previous one, and a released record is
+// reused by the next allocation, so the memory is proportional to the most processes alive at the same time,
+// and not to all the processes of the simulation. The records never move, so pointers to them stay valid
+typedef struct process_table ProcessTable;
+
+// Creates and returns an empty table
+ProcessTable* process_table_create(void);
+
+// Returns a record for a new process, not initialized
+Process* process_table_alloc(ProcessTable* table);
+
+// The process is finished, so its record is given back to the table, to be reused
+void process_table_release(ProcessTable* table, Process* proc);
+
+// Number of processes allocated and not released yet
+int process_table_live(ProcessTable* table);
+
+// Number of records allocated by the table, the most processes that were alive at the same time, rounded up to a block
+int process_table_capacity(ProcessTable* table);
+
+// Deallocates the memory of the table and of all its processes
+void process_table_destroy(ProcessTable* table);
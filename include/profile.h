@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////
+// Profile
+// Phase timers and event counters of the hot path of the simulator.
+// They are compiled in only with -DPROFILE, else every macro is empty
+// and the instrumentation costs nothing
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Phases of a time slot, timed separately
+typedef enum {
+	PHASE_ARRIVALS,		// the arrivals are taken from the source and inserted into the ready_pqs
+	PHASE_EXPIRY,		// the running and the ready processes that passed their lifetime are finished
+	PHASE_STEALING,		// work stealing between the cpus
+	PHASE_SCHEDULING,	// the competitor is compared with the running process, preemptions
+	PHASE_SEMAPHORES,	// the running process enters, continues or exits its CS
+	PHASE_TRACE,		// the running state is written to the trace
+	PHASE_WAITING,		// incr_proc_waiting_time
+	PHASE_CS_STRETCH,	// event-driven mode: stretches of CS slots run at once
+	PHASE_RUN_STRETCH,	// event-driven mode: stretches of slots out of the CS run at once
+	PHASES
+} ProfilePhase;
+
+// Events counted
+typedef enum {
+	COUNT_SLOTS,			// time slots simulated one by one
+	COUNT_SIFT_STEPS,		// levels a node moves in a heap(ADTPriorityQueue, ADTReadyHeap)
+	COUNT_PREEMPTIONS,		// a running process is replaced by a higher priority one
+	COUNT_BLOCKS,			// a process is blocked for a slot
+	COUNT_SEM_ACQUIRES,		// a process gets a semaphore
+	COUNT_ALLOCATIONS,		// malloc/realloc of the ADTs and the process table, after their creation
+	COUNTERS
+} ProfileCounter;
+
+typedef struct profile {
+	uint64_t time[PHASES];		// ticks spent in each phase
+	uint64_t calls[PHASES];		// times each phase ran
+	uint64_t total;				// ticks of the whole main loop
+	uint64_t counters[COUNTERS];
+} Profile;
+
+// Every thread has its own profile, so the simulations of the replications don't share the counters
+extern _Thread_local Profile profile_data;
+
+// Ticks of rdtsc(cpu cycles) on x86, nanoseconds of clock_gettime anywhere else
+uint64_t profile_now(void);
+
+// Name of the unit of profile_now()
+const char* profile_unit(void);
+
+// Prints the time of every phase, as ticks and as a percentage of the main loop, and the event counters.
+// Prints only a note if the profiler isn't compiled in
+void profile_print(Profile* profile, FILE* out);
+
+#ifdef PROFILE
+
+#define PROFILE_START(phase)	uint64_t profile_start_##phase = profile_now()
+#define PROFILE_END(phase)		do { profile_data.time[phase] += profile_now() - profile_start_##phase; \
+									 profile_data.calls[phase]++; } while (0)
+#define PROFILE_COUNT(counter)	(profile_data.counters[counter]++)
+#define PROFILE_ADD(counter, n)	(profile_data.counters[counter] += (n))
+#define PROFILE_TOTAL_START()	uint64_t profile_total_start = profile_now()
+#define PROFILE_TOTAL_END()		(profile_data.total += profile_now() - profile_total_start)
+
+#else
+
+#define PROFILE_START(phase)
+#define PROFILE_END(phase)		((void)0)
+#define PROFILE_COUNT(counter)	((void)0)
+#define PROFILE_ADD(counter, n)	((void)0)
+#define PROFILE_TOTAL_START()
+#define PROFILE_TOTAL_END()		((void)0)
+
+#endif
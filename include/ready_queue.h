@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////
+// Ready queue
+// The processes that have arrived and wait to run, with a selectable implementation
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include "common_types.h"
+#include "ADTPriorityQueue.h"
+
+// Implementations of the ready queue
+typedef enum {
+	READY_PQUEUE,	// generic PriorityQueue, ordered by the compare function given
+	READY_HEAP,		// ReadyHeap, with the keys inline
+	READY_MULTILEVEL	// MultilevelQueue, one FIFO bucket per priority(1..7)
+} ReadyQueueType;
+
+// The ready queue is implemented using a struct ReadyQueue
+typedef struct ready_queue ReadyQueue;
+
+// Handle of an element of the ready queue, used for its removal. Which member is used depends on the ReadyQueueType
+typedef union ready_handle {
+	PriorityQueueNode* node;	// READY_PQUEUE
+	int id;						// READY_HEAP, READY_MULTILEVEL
+} ReadyHandle;
+
+// Creates and returns an empty ready queue of the given type, with memory for capacity elements
+// compare is used only by READY_PQUEUE, and has to order the elements by (priority, arrival_time, pid) like the others
+ReadyQueue* ready_queue_create(ReadyQueueType type, CompareFunc compare, int capacity);
+
+// Ready queue size
+int ready_queue_size(ReadyQueue* ready_queue);
+
+// Value with the highest priority
+void* ready_queue_max(ReadyQueue* ready_queue);
+
+// Inserts value with the given keys and returns its handle
+ReadyHandle ready_queue_insert(ReadyQueue* ready_queue, int priority, double arrival_time, int pid, void* value);
+
+// The priority of the element with that handle changes to priority, and it moves to its new position. Its handle stays the same.
+// READY_PQUEUE reads the priority through the compare function, so the value has to be updated before
+void ready_queue_update_priority(ReadyQueue* ready_queue, ReadyHandle handle, int priority);
+
+// Removes the value with the highest priority and returns it
+void* ready_queue_remove_max(ReadyQueue* ready_queue);
+
+// Removes the element with that handle, which can be in any position of the ready queue
+void ready_queue_remove(ReadyQueue* ready_queue, ReadyHandle handle);
+
+// Deallocates the memory used by ready_queue
+void ready_queue_destroy(ReadyQueue* ready_queue);
@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////
+// Replications
+// Independent runs of the same simulation on a pool of threads
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdint.h>
+#include "simulation.h"
+
+// The stream of every replication, the stream of seed after i rng_long_jump()s for replication i, to streams[0..replications-1]
+void replication_streams(uint64_t seed, int replications, Rng* streams);
+
+// Runs simulations simulations on threads threads, simulation i with params[i] and streams[i], and stores its results
+// to stats[i]. The stats[i].busy_slots are allocated here, with params[i]->cpus ints each
+void run_simulations(SimulationParams** params, Rng* streams, int simulations, int threads, SimulationStats* stats);
+
+// Runs replications independent simulations with params, on threads threads, and stores the results of
+// replication i to stats[i]. Replication i draws its random numbers from the stream of seed after i rng_long_jump()s,
+// so the replications are independent, the results don't depend on the number of threads, and replication 0
+// is the same as a single simulation with that seed. The stats[i].busy_slots are allocated here, with params->cpus ints each
+void run_replications(SimulationParams* params, int replications, int threads, uint64_t seed, SimulationStats* stats);
+
+// Mean of the n values and the half width of their 95% confidence interval, NAN for a single value, which has no interval
+void mean_ci(double* values, int n, double* mean, double* half_width);
+
+// Prints the mean and the 95% confidence interval of the stats of all the replications, per priority, and of the
+// utilization of every cpu if there are more than one
+void print_replication_stats(SimulationStats* stats, int replications, int cpus);
+
+// Runs replications replications of params with every --sem-protocol, on the semaphore wait queues, all from the same seed
+// so that every protocol gets the same processes, and prints the mean blocked time of every priority with each protocol,
+// and how much of it the inheritance and the ceiling protocols save compared to none, with their 95% confidence intervals.
+// None is the queued model(sem_queues) without a protocol, not the default one, where the blocked processes spin
+void compare_protocols(SimulationParams* params, int replications, int threads, uint64_t seed);
+
+// Deallocates the memory of the stats of the replications, allocated by run_replications
+void destroy_replication_stats(SimulationStats* stats, int replications);
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////
+// Random number generator
+// xoshiro256**, with its own state for every simulation instead of the global state of rand()
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdint.h>
+
+// The state of the generator. It's small, so it's kept by value, e.g. in the stack of every simulation
+typedef struct rng {
+	uint64_t s[4];
+} Rng;
+
+// Initializes the state of rng from seed. The same seed always gives the same numbers
+void rng_seed(Rng* rng, uint64_t seed);
+
+// Advances rng by 2^128 numbers. Calling it repeatedly on a copy of the same state gives independent streams
+// that never overlap, e.g. one for the generation of the processes and one for the scheduling decisions
+void rng_jump(Rng* rng);
+
+// Advances rng by 2^192 numbers, for streams that contain 2^64 rng_jump() streams each, e.g. one per replication
+void rng_long_jump(Rng* rng);
+
+// The next number is in the header, so that it can be inlined in the loops that draw random numbers
+
+static inline uint64_t rng_rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+// Returns the next 64 random bits
+static inline uint64_t rng_next(Rng* rng) {
+	uint64_t* s = rng->s;
+	uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rng_rotl(s[3], 45);
+	return result;
+}
+
+// Returns a random double in [0, 1), from the 53 high bits of the next number
+static inline double rng_double(Rng* rng) { return (rng_next(rng) >> 11) * 0x1.0p-53; }
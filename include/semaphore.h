@@ -1,19 +1,60 @@
+#pragma once // #include once
+
 #include <stdbool.h>
+#include "common_types.h"
+#include "ADTPriorityQueue.h"
 
 // a semaphore is a pointer to this struct
 typedef struct semaphore* Semaphore;
 
-// returns an array of S pointers to struct semaphore
-Semaphore* create_semaphores(int S);
+// Protocols against priority inversion, the priority a process runs with while it holds a semaphore
+typedef enum {
+	SEM_PROTOCOL_NONE,			// its own
+	SEM_PROTOCOL_INHERITANCE,	// the highest priority of its own and of the processes blocked on the semaphore, through chains of blocked holders too
+	SEM_PROTOCOL_CEILING		// the highest priority of its own and of the ceiling of the semaphore
+} SemProtocol;
+
+// The ceiling of every semaphore, the highest priority of the processes that can use it. Every process can use any semaphore,
+// so it's the highest priority
+#define SEM_CEILING 1
+
+// returns an array of S pointers to struct semaphore, each one with count units, so that up to count processes
+// can be in their CS at the same time(count = 1 for binary semaphores). The processes blocked on a semaphore
+// wait in its wait queue, ordered by waiter_compare
+Semaphore* create_semaphores(int S, int count, CompareFunc waiter_compare);
 
 // deallocated the memory of the semaphores created
 void destroy_semaphores(Semaphore* sem_set, int S);
 
-// process enters its CS
-void sem_down(Semaphore sem, int pid);
+// process attempts to enter its CS. Returns false if all the units of the semaphore are used by other processes,
+// in which case the process is blocked. Returns true if it already holds a unit
+bool sem_try_down(Semaphore sem, void* proc);
+
+// process exits its CS, and its unit is handed directly to the highest priority process of the wait queue,
+// which is removed from the queue and returned. NULL if no process is blocked on the semaphore, or if proc doesn't hold a unit
+void* sem_up(Semaphore sem, void* proc);
+
+// true if proc holds a unit of the semaphore, so it is in its CS
+bool sem_holds(Semaphore sem, void* proc);
+
+// number of processes holding a unit of the semaphore, and the i-th of them, i < sem_used(sem)
+int sem_used(Semaphore sem);
+void* sem_holder(Semaphore sem, int i);
+
+// proc is blocked on the semaphore, till a process that holds it calls sem_up. Returns its node in the wait queue
+PriorityQueueNode* sem_wait(Semaphore sem, void* proc);
+
+// the process of node isn't blocked any more, without getting the semaphore
+void sem_cancel_wait(Semaphore sem, PriorityQueueNode* node);
+
+// number of processes blocked on the semaphore
+int sem_waiters(Semaphore sem);
+
+// the highest priority process blocked on the semaphore, the one sem_up() hands it to
+void* sem_max_waiter(Semaphore sem);
 
-// process exits its CS
-void sem_up(Semaphore sem);
+// the priority of the process of node changed, so it moves to its new position in the wait queue
+void sem_update_waiter(Semaphore sem, PriorityQueueNode* node);
 
-// returns the pid of the proccess using the semaphore now
-int sem_used_by_process(Semaphore sem);
\ No newline at end of file
+// returns the id of the semaphore, its position in the set of semaphores
+int sem_id(Semaphore sem);
\ No newline at end of file
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////
+// Simulation
+// One run of the scheduling simulator, with its parameters and results
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "ready_queue.h"
+#include "trace.h"
+#include "rng.h"
+#include "workload.h"
+#include "aggregate.h"
+#include "semaphore.h"
+
+#define PRIORITIES 7	// priorities of the processes are 1..7
+
+// Parameters of a simulation, given from the command line
+typedef struct simulation_params {
+	double lambda_arrival;
+	double lambda_lifetime;
+	double lambda_cs_time;
+	int total_processes;
+	Workload* workload;		// processes replayed instead of generated from the lambdas and total_processes, NULL if none
+	int k;					// down() probability
+	int S;					// number of semaphores
+	int sem_count;			// units of every semaphore, 1 for binary semaphores
+	bool sem_queues;		// the blocked processes wait in the wait queue of the semaphore, instead of attempting again every slot
+	SemProtocol sem_protocol;	// the priority of the processes in their CS, with sem_queues
+	int cpus;				// number of simulated cpus
+	bool event_driven;		// jump between events instead of stepping every time slot
+	ReadyQueueType ready_queue_type;
+} SimulationParams;
+
+// Results of a simulation, per priority: priority 1 at [0], priority 2 at [1], etc
+typedef struct simulation_stats {
+	int waiting_time_slots[PRIORITIES];
+	int blocked_time_slots[PRIORITIES];
+	int running_time_slots[PRIORITIES];
+	int cs_time_slots[PRIORITIES];
+	int total_slots;		// time slots till all the processes finished
+	Aggregate response[PRIORITIES];		// start_time - arrival_time of every finished process that got a cpu
+	Aggregate turnaround[PRIORITIES];	// of every finished process, its end_time - arrival_time. Their count is the number of finished processes
+	Aggregate waiting[PRIORITIES];		// waiting_time of every finished process
+	Aggregate blocked[PRIORITIES];		// blocked_time of every finished process
+	int* busy_slots;		// time slots in which each cpu was running a process, allocated by the caller with params->cpus ints
+} SimulationStats;
+
+#define COMPLETION_LOG_HEADER "pid,priority,arrival_time,start_time,end_time,turnaround,waiting_time,blocked_time,running_time"
+
+// Runs one simulation with params and stores its results in stats. The random numbers are drawn from independent
+// streams jumped from stream, which isn't changed, and the running state of every slot is written to running_state_trace, if it's not NULL.
+// Every finished process is appended to completion_log as a line of COMPLETION_LOG_HEADER, if it's not NULL.
+// Everything else it uses is local to it, so many simulations can run at the same time, on different threads
+void simulate(SimulationParams* params, Rng* stream, Trace* running_state_trace, FILE* completion_log, SimulationStats* stats);
+
+// Prints the stats of a simulation, per priority, and the utilization of every cpu if there are more than one
+void print_stats(SimulationStats* stats, int cpus);
+
+// Prints the histograms of the response, turnaround, waiting and blocked time of the finished processes, per priority
+void print_histograms(SimulationStats* stats);
+
+// Writes the histograms of print_histograms to filename, as JSON if its name ends in .json, else as CSV
+// Returns false if the file can't be written
+bool dump_histograms(SimulationStats* stats, const char* filename);
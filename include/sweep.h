@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////
+// Sweep
+// The simulations of a grid of parameters, with common random numbers
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdio.h>
+#include <stdint.h>
+#include "simulation.h"
+
+#define SWEEP_MAX_VALUES 64		// values of every parameter of the grid
+
+// The parameters of the grid, in the order of the command line
+typedef enum {
+	SWEEP_LAMBDA_ARRIVAL,
+	SWEEP_LAMBDA_LIFETIME,
+	SWEEP_LAMBDA_CS_TIME,
+	SWEEP_TOTAL_PROCESSES,
+	SWEEP_K,
+	SWEEP_S,
+	SWEEP_PARAMS
+} SweepParam;
+
+// The values of every parameter of the grid
+typedef struct sweep_grid {
+	double values[SWEEP_PARAMS][SWEEP_MAX_VALUES];
+	int count[SWEEP_PARAMS];
+} SweepGrid;
+
+// Sets the values of param in grid from list, comma separated numbers like "0.1,0.5,1"
+// Returns false if list isn't a list of up to SWEEP_MAX_VALUES numbers
+bool sweep_parse(SweepGrid* grid, SweepParam param, const char* list);
+
+// Runs replications replications of every combination of the values of grid, with the rest of the parameters of params,
+// on threads threads, and writes the mean and the 95% confidence interval of the stats of every combination and priority
+// to out, as CSV. The processes of every replication are generated once for every lambda_arrival, lambda_lifetime,
+// lambda_cs_time and total_processes, and replayed by all the combinations of k and S, which draw their scheduling
+// decisions from the same stream too(common random numbers), so replication r of every combination is the same as
+// a single simulation of it with seed, after r rng_long_jump()s. With params->workload, the processes of the workload
+// are replayed by all the combinations, and only the k and S of grid are used
+void run_sweep(SimulationParams* params, SweepGrid* grid, int replications, int threads, uint64_t seed, FILE* out);
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////
+// Running state trace
+// Buffered writer of the running state of every time slot
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRACE_DEFAULT_BUFFER_SIZE	(1 << 20)	// 1MB
+#define TRACE_MIN_BUFFER_SIZE		256			// enough for at least a couple of records
+
+// Formats of the trace file
+typedef enum {
+	TRACE_TEXT,		// one line per event, "Running now Process with PID: ..", "Finishing now Process with PID: .."
+	TRACE_BINARY	// header followed by fixed-width TraceRecords
+} TraceFormat;
+
+// ===================== Binary format ===================== //
+// The file starts with a TraceHeader and continues with TraceRecords, both in the byte order of the host.
+// A RUNNING record covers "count" consecutive slots of the same process, in which its service time is increased by 1
+// every slot and it uses the same semaphore, so that a process running for many slots takes only a few records.
+
+#define TRACE_MAGIC		"RSTR"
+#define TRACE_VERSION	1
+#define TRACE_MAX_COUNT	UINT8_MAX	// max slots of a RUNNING record
+
+typedef enum {
+	TRACE_EVENT_RUNNING = 0,	// the process runs in this slot
+	TRACE_EVENT_FINISHING = 1	// the process passed its lifetime in this slot
+} TraceEvent;
+
+typedef struct trace_header {
+	char magic[4];				// TRACE_MAGIC
+	uint16_t version;			// TRACE_VERSION
+	uint16_t record_size;		// sizeof(TraceRecord)
+} TraceHeader;
+
+typedef struct trace_record {
+	uint32_t slot;				// time slot of the (first) event
+	int32_t pid;
+	uint32_t service_time;		// service time in the (first) slot, 0 for FINISHING
+	int16_t semid;				// semaphore held by the process while running, -1 if none
+	uint8_t event;				// TraceEvent
+	uint8_t count;				// consecutive slots covered by this record, 1 for FINISHING
+} TraceRecord;
+
+// ===================== Trace writer ===================== //
+
+// The trace is implemented using a struct Trace
+// Every function accepts a NULL trace too, which means that tracing is disabled and nothing is written
+typedef struct trace Trace;
+
+// Opens(and truncates) the file filename once and returns a Trace that writes into a buffer of buffer_size bytes,
+// with the given format. The buffer is flushed to the file when it's full, and also every flush_every records if flush_every > 0
+// Returns NULL if the file can't be opened
+Trace* trace_open(const char* filename, TraceFormat format, int buffer_size, int flush_every);
+
+// The process with that pid runs in this time slot, and it has run for service_time time slots till now
+// semid is the id of the semaphore it holds, -1 if it doesn't hold any
+void trace_running(Trace* trace, int slot, int pid, int service_time, int semid);
+
+// The process with that pid just passed its lifetime
+void trace_finishing(Trace* trace, int slot, int pid);
+
+// Writes everything buffered till now to the file
+void trace_flush(Trace* trace);
+
+// Flushes the buffer, closes the file and deallocates the memory used by trace
+void trace_close(Trace* trace);
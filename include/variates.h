@@ -0,0 +1,21 @@
+///////////////////////////////////////////////////////////////////
+// Batch variates
+// Random variates generated in arrays, with loops that the compiler can vectorize
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include "rng.h"
+
+// Fills u[0..n-1] with uniform doubles in [0, 1), the next n numbers of rng
+void uniform_batch(Rng* rng, double* u, int n);
+
+// Fills out[0..n-1] with exponential variates with parameter lambda, from the uniforms u[0..n-1],
+// out[i] = -log(1 - u[i]) / lambda, the same as rand_exponential() gives for u[i], up to the last bit
+void exponential_batch(const double* restrict u, double* restrict out, int n, double lambda);
+
+// Fills out[0..n-1] with uniform integers in [low, high], from the uniforms u[0..n-1], the same as rand_uniform()
+void uniform_int_batch(const double* restrict u, int* restrict out, int n, int low, int high);
+
+// out[i] = start + in[0] + .. + in[i], and returns out[n-1](start if n = 0). in and out can be the same array
+double prefix_sum(const double* in, double* out, int n, double start);
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////
+// Workload file
+// Processes captured elsewhere, replayed instead of the generated ones,
+// read straight from the file mapped in memory
+///////////////////////////////////////////////////////////////////
+
+#pragma once // #include once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Formats of the workload file
+typedef enum {
+	WORKLOAD_CSV,		// one line per process, "arrival_time,lifetime,priority,cs_time"
+	WORKLOAD_BINARY		// header followed by fixed-width WorkloadRecords
+} WorkloadFormat;
+
+// ===================== CSV format ===================== //
+// One process per line, ordered by arrival_time. The lifetime counts from the arrival of the process, like the
+// lifetimes drawn with lambda_lifetime. Empty lines, lines starting with '#', and a first line that doesn't start
+// with a number(a header, like WORKLOAD_CSV_HEADER) are skipped
+
+#define WORKLOAD_CSV_HEADER		"arrival_time,lifetime,priority,cs_time"
+#define WORKLOAD_MAX_LINE		256		// longest line of a CSV workload
+
+// ===================== Binary format ===================== //
+// The file starts with a WorkloadHeader and continues with header.count WorkloadRecords, ordered by arrival_time,
+// both in the byte order of the host. The records are 8-byte aligned in the file, so they're read in place
+
+#define WORKLOAD_MAGIC		"RSWL"
+#define WORKLOAD_VERSION	1
+
+typedef struct workload_header {
+	char magic[4];				// WORKLOAD_MAGIC
+	uint16_t version;			// WORKLOAD_VERSION
+	uint16_t record_size;		// sizeof(WorkloadRecord)
+	uint64_t count;				// number of records
+} WorkloadHeader;
+
+typedef struct workload_record {
+	double arrival_time;
+	double lifetime;			// counts from the arrival_time
+	double cs_time;
+	int32_t priority;			// 1..7
+	int32_t reserved;			// 0
+} WorkloadRecord;
+
+// ===================== Workload reader ===================== //
+
+// The workload is implemented using a struct Workload, the file mapped read only in memory
+// It isn't changed by the readers, so many simulations can replay the same workload at the same time
+typedef struct workload Workload;
+
+// Maps the file filename in memory, and finds its format from its first bytes(WORKLOAD_MAGIC for the binary format)
+// Returns NULL if the file can't be opened or mapped. Exits with an error message if it's a binary workload with a wrong header
+Workload* workload_open(const char* filename);
+
+// Creates a binary workload in memory, with the count records, which are freed by workload_close
+Workload* workload_create(WorkloadRecord* records, size_t count);
+
+// Format of the workload
+WorkloadFormat workload_format(Workload* workload);
+
+// Reads the process at the position *pos of the workload into record, and moves *pos to the next one
+// *pos = 0 for the first process. Returns false if there are no more processes
+// Exits with an error message, with the line or the record, if the process isn't valid
+bool workload_read(Workload* workload, size_t* pos, WorkloadRecord* record);
+
+// Unmaps the file and deallocates the memory of the workload, and its records if it was created in memory
+void workload_close(Workload* workload);
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////
+// ADT MultilevelQueue implementation using a doubly linked
+// list per level and a bitmap of the non-empty levels
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "ADTMultilevelQueue.h"
+#include "profile.h"
+
+#define MULTILEVEL_MIN_CAPACITY 16
+#define NONE -1		// no node
+
+// The nodes are stored in an array, and the handle of an element is the index of its node,
+// so the links are indices too, and they stay valid when the array grows
+typedef struct multilevel_node {
+	double arrival_time;
+	int pid;
+	int priority;
+	int prev, next;			// neighbours in the list of the level, or in the list of free nodes(next only)
+	void* value;
+} Node;
+
+typedef struct level {
+	int first, last;		// NONE if the level is empty
+} Level;
+
+struct multilevel_queue {
+	Level levels[MULTILEVEL_MAX_LEVELS];
+	int level_count;
+	uint64_t non_empty;		// bit i is set if level i(priority i + 1) is not empty
+
+	Node* nodes;
+	int capacity;			// allocated nodes
+	int used;				// nodes given till now, the rest are not initialized yet
+	int free_nodes;			// list of nodes of removed elements, linked through next
+	int size;
+};
+
+// true if the node a has to be before the node b in their level
+static inline bool node_before(const Node* a, const Node* b) {
+	if (a->arrival_time != b->arrival_time)
+		return a->arrival_time < b->arrival_time;
+	return a->pid < b->pid;
+}
+
+// Returns the index of a node that is not used by any element
+static int node_create(MultilevelQueue* queue) {
+	if (queue->free_nodes != NONE) {
+		int node = queue->free_nodes;
+		queue->free_nodes = queue->nodes[node].next;
+		return node;
+	}
+
+	// If the array is full, we double its capacity
+	if (queue->used == queue->capacity) {
+		queue->capacity *= 2;
+		queue->nodes = realloc(queue->nodes, queue->capacity * sizeof(*queue->nodes));
+		PROFILE_COUNT(COUNT_ALLOCATIONS);
+	}
+	return queue->used++;
+}
+
+// Links node id into its level, right after the node after_id(or first if after_id is NONE)
+static void link_after(MultilevelQueue* queue, Level* level, int after_id, int id) {
+	Node* node = &queue->nodes[id];
+	node->prev = after_id;
+	node->next = after_id == NONE ? level->first : queue->nodes[after_id].next;
+
+	if (node->prev == NONE)
+		level->first = id;
+	else
+		queue->nodes[node->prev].next = id;
+
+	if (node->next == NONE)
+		level->last = id;
+	else
+		queue->nodes[node->next].prev = id;
+}
+
+// Links node id into the level of its priority, at its position by arrival_time and pid
+static void link_sorted(MultilevelQueue* queue, int id) {
+	Node* node = &queue->nodes[id];
+
+	// Processes usually come in arrival order, so they go to the end of their level, and a preempted process
+	// usually goes to the start of it. Only if it belongs somewhere in the middle, we look for its position
+	Level* level = &queue->levels[node->priority - 1];
+	int after = level->last;
+	while (after != NONE && node_before(node, &queue->nodes[after])) {
+		if (node_before(node, &queue->nodes[level->first])) {
+			after = NONE;
+			break;
+		}
+		after = queue->nodes[after].prev;
+	}
+	link_after(queue, level, after, id);
+	queue->non_empty |= UINT64_C(1) << (node->priority - 1);
+}
+
+// Unlinks node id from its level, the node itself isn't changed
+static void unlink_node(MultilevelQueue* queue, int id) {
+	Node* node = &queue->nodes[id];
+	Level* level = &queue->levels[node->priority - 1];
+
+	if (node->prev == NONE)
+		level->first = node->next;
+	else
+		queue->nodes[node->prev].next = node->next;
+
+	if (node->next == NONE)
+		level->last = node->prev;
+	else
+		queue->nodes[node->next].prev = node->prev;
+
+	if (level->first == NONE)
+		queue->non_empty &= ~(UINT64_C(1) << (node->priority - 1));
+}
+
+//// ======================================= ADTMultilevelQueue ======================================= ////
+
+MultilevelQueue* multilevel_create(int levels, int capacity) {
+	assert(levels > 0 && levels <= MULTILEVEL_MAX_LEVELS);
+
+	MultilevelQueue* queue = malloc(sizeof(*queue));
+	for (int i = 0; i < levels; i++)
+		queue->levels[i].first = queue->levels[i].last = NONE;
+	queue->level_count = levels;
+	queue->non_empty = 0;
+
+	queue->capacity = capacity < MULTILEVEL_MIN_CAPACITY ? MULTILEVEL_MIN_CAPACITY : capacity;
+	queue->nodes = malloc(queue->capacity * sizeof(*queue->nodes));
+	queue->used = 0;
+	queue->free_nodes = NONE;
+	queue->size = 0;
+	return queue;
+}
+
+int multilevel_size(MultilevelQueue* queue) { return queue->size; }
+
+void* multilevel_max(MultilevelQueue* queue) {
+	assert(queue->size != 0);
+
+	// the highest priority non-empty level is the lowest bit set
+	int level = __builtin_ctzll(queue->non_empty);
+	return queue->nodes[queue->levels[level].first].value;
+}
+
+int multilevel_insert(MultilevelQueue* queue, int priority, double arrival_time, int pid, void* value) {
+	assert(priority >= 1 && priority <= queue->level_count);
+
+	int id = node_create(queue);
+	Node* node = &queue->nodes[id];
+	node->arrival_time = arrival_time;
+	node->pid = pid;
+	node->priority = priority;
+	node->value = value;
+	link_sorted(queue, id);
+
+	queue->size++;
+	return id;
+}
+
+void multilevel_update_priority(MultilevelQueue* queue, int handle, int priority) {
+	assert(handle >= 0 && handle < queue->used);
+	assert(priority >= 1 && priority <= queue->level_count);
+
+	// the node moves to the level of its new priority, keeping its handle
+	unlink_node(queue, handle);
+	queue->nodes[handle].priority = priority;
+	link_sorted(queue, handle);
+}
+
+void multilevel_remove(MultilevelQueue* queue, int handle) {
+	assert(handle >= 0 && handle < queue->used);
+
+	Node* node = &queue->nodes[handle];
+	unlink_node(queue, handle);
+
+	// the node can be reused by a next insert
+	node->next = queue->free_nodes;
+	queue->free_nodes = handle;
+	queue->size--;
+}
+
+void* multilevel_remove_max(MultilevelQueue* queue) {
+	assert(queue->size != 0);
+
+	int first = queue->levels[__builtin_ctzll(queue->non_empty)].first;
+	void* max = queue->nodes[first].value;
+	multilevel_remove(queue, first);
+	return max;
+}
+
+void multilevel_destroy(MultilevelQueue* queue) {
+	free(queue->nodes);
+	free(queue);
+}
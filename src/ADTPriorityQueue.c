@@ -7,16 +7,25 @@
 #include <stdio.h>
 #include "ADTPriorityQueue.h"
 #include "ADTVector.h"
+#include "profile.h"
+
+// Nodes are allocated in blocks, every block twice the size of the previous one, starting from NODE_BLOCK_MIN_SIZE nodes
+#define NODE_BLOCK_MIN_SIZE 64
 
 struct priority_queue {
 	Vector* vector;				// Vector for the data, so that we have a dynamic array
 	CompareFunc compare;		// Order of the values in pqueue
 	DestroyFunc destroy_value;	// Function that destroys an element of the vector.
+
+	// Pool of the nodes, so that insert and remove don't allocate/free memory for every node
+	Vector* node_blocks;		// all the blocks of nodes allocated, freed when the pqueue is destroyed
+	int next_block_size;		// number of nodes of the next block to be allocated
+	PriorityQueueNode* free_nodes;	// nodes not in the heap, linked through their value
 };
 
 // All ids of the nodes are 1-based in the pqueue but 0-based in the vector
 struct priority_queue_node {
-	void* value;				// Node's value
+	void* value;				// Node's value, or the next free node if the node is not in the heap
 	int id;						// Position in vector
 	PriorityQueue* owner;		// Pointer for accessing the pqueue, from a node
 };
@@ -39,12 +48,33 @@ void node_swap(PriorityQueue* pqueue, int node1_id, int node2_id) {
 	node2->id = temp;
 }
 
+// Takes a node from the pool of free nodes. If there's no free node, a new block of nodes is allocated
 PriorityQueueNode* pqueue_node_create(PriorityQueue* pqueue, void* value, int pos) {
-    PriorityQueueNode* node = malloc(sizeof(*node));
-    node->value = value;
+	if (pqueue->free_nodes == NULL) {
+		int block_size = pqueue->next_block_size;
+		PriorityQueueNode* block = malloc(block_size * sizeof(*block));
+		PROFILE_COUNT(COUNT_ALLOCATIONS);
+		vector_insert_last(pqueue->node_blocks, block);
+		pqueue->next_block_size *= 2;
+
+		// all the nodes of the new block are free
+		for (int i = 0; i < block_size; i++)
+			block[i].value = i + 1 < block_size ? &block[i + 1] : NULL;
+		pqueue->free_nodes = block;
+	}
+
+	PriorityQueueNode* node = pqueue->free_nodes;
+	pqueue->free_nodes = node->value;
+	node->value = value;
 	node->id = pos;
 	node->owner = pqueue;
-    return node;
+	return node;
+}
+
+// Returns the node, which is not in the heap any more, to the pool of free nodes
+static void pqueue_node_release(PriorityQueue* pqueue, PriorityQueueNode* node) {
+	node->value = pqueue->free_nodes;
+	pqueue->free_nodes = node;
 }
 
 // Compare the values of tho nodes, accordinf to the initial compare function
@@ -58,61 +88,70 @@ static void destroy_pq_node(PriorityQueueNode* node) {
 		node->owner->destroy_value(node->value);
 	
 	vector_remove_last(node->owner->vector);
-	free(node);
+	pqueue_node_release(node->owner, node);
 }
 
 // Before, all the nodes, except for the node with id node_id that can be greater than its father, satisfy the heap property
 // Calling bubble_up restores the heap property
 static void bubble_up(PriorityQueue* pqueue, int node_id) {
 	// If we've reached the root, we stop
-	if (node_id == 1)
-		return;
-	
-	int parent = node_id / 2;
+	while (node_id > 1) {
+		int parent = node_id / 2;
 
-	PriorityQueueNode* parent_node = node_value(pqueue, parent);
-	PriorityQueueNode* node = node_value(pqueue, node_id);
+		PriorityQueueNode* parent_node = node_value(pqueue, parent);
+		PriorityQueueNode* node = node_value(pqueue, node_id);
 
-	// If the parent has a smaller value than the node, we swap and continue going up recursively
-	if (compare_pq_nodes(parent_node, node) < 0) {
+		// If the parent has a smaller value than the node, we swap and continue going up
+		if (compare_pq_nodes(parent_node, node) >= 0)
+			return;
 		node_swap(pqueue, parent, node_id);
-		bubble_up(pqueue, parent);
+		PROFILE_COUNT(COUNT_SIFT_STEPS);
+		node_id = parent;
 	}
 }
 
 // Before, all the nodes, except for the node with id node_id that can be smaller than one of its children, satisfy the heap property
-// Calling bubble_up restores the heap property
+// Calling bubble_down restores the heap property
 static void bubble_down(PriorityQueue* pqueue, int node_id) {
-	
-	PriorityQueueNode* node = node_value(pqueue, node_id);
-	// We find the children of the node
-	int left_child = 2 * node_id;
-	int right_child = left_child + 1;
-	
-	// No left children, means no right one
 	int size = pqueue_size(pqueue);
-	if (left_child > size)
-		return;
 
-	// Max of the two children
-	int max_child = left_child;
-	PriorityQueueNode* left_child_node = node_value(pqueue, left_child);
-	
-	if (right_child <= size) {
-		PriorityQueueNode* right_child_node = node_value(pqueue, right_child);
-		if(compare_pq_nodes(left_child_node, right_child_node) < 0)
-			max_child = right_child;
-	}
+	while (true) {
+		PriorityQueueNode* node = node_value(pqueue, node_id);
+		// We find the children of the node
+		int left_child = 2 * node_id;
+		int right_child = left_child + 1;
+
+		// No left children, means no right one
+		if (left_child > size)
+			return;
+
+		// Max of the two children
+		int max_child = left_child;
+		PriorityQueueNode* left_child_node = node_value(pqueue, left_child);
 
-	PriorityQueueNode* max_child_node = node_value(pqueue, max_child);
+		if (right_child <= size) {
+			PriorityQueueNode* right_child_node = node_value(pqueue, right_child);
+			if(compare_pq_nodes(left_child_node, right_child_node) < 0)
+				max_child = right_child;
+		}
 
-	// If the node is smaller than the max child, we swap and continue going down recursively
-	if (compare_pq_nodes(node, max_child_node) < 0) {
+		PriorityQueueNode* max_child_node = node_value(pqueue, max_child);
+
+		// If the node is smaller than the max child, we swap and continue going down
+		if (compare_pq_nodes(node, max_child_node) >= 0)
+			return;
 		node_swap(pqueue, node_id, max_child);
-		bubble_down(pqueue, max_child);
+		PROFILE_COUNT(COUNT_SIFT_STEPS);
+		node_id = max_child;
 	}
 }
 
+#ifdef PQUEUE_CHECK_INVARIANT
+// After every operation that changes the pqueue, the heap property is checked
+#define CHECK_INVARIANT(pqueue) assert(pqueue_check_invariant(pqueue))
+#else
+#define CHECK_INVARIANT(pqueue)
+#endif
 
 static void pqueue_insert_values(PriorityQueue* pqueue, Vector* values) {
 	int size = vector_size(values);
@@ -140,21 +179,31 @@ static void heapify(PriorityQueue* pqueue, Vector* values) {
 
 //// ======================================= ADTPriorityQueue ======================================= ////
 
-PriorityQueue* pqueue_create(CompareFunc compare, DestroyFunc destroy_value, Vector* values) {
+PriorityQueue* pqueue_create(CompareFunc compare, DestroyFunc destroy_value, Vector* values, int capacity) {
 	assert(compare != NULL);
+	if (values != NULL && vector_size(values) > capacity)
+		capacity = vector_size(values);
 
 	PriorityQueue* pqueue = malloc(sizeof(*pqueue));
 	pqueue->compare = compare;
 	pqueue->destroy_value = destroy_value;
+	pqueue->node_blocks = vector_create(0, free);	// the blocks are freed when the pqueue is destroyed
+	pqueue->next_block_size = capacity > NODE_BLOCK_MIN_SIZE ? capacity : NODE_BLOCK_MIN_SIZE;	// the first block has all the nodes of capacity
+	pqueue->free_nodes = NULL;
 
 	// Creating the vector of the values, but not storing the destroy_value too
-	// as when we swap 2 elements, destroy_value is gonna be called, which is something we don't want 
+	// as when we swap 2 elements, destroy_value is gonna be called, which is something we don't want
+	// The nodes are never freed, so the vector of the pointers to them isn't shrunk either, and a pqueue whose size
+	// goes up and down doesn't reallocate it
 	pqueue->vector = vector_create(0, NULL);
+	vector_reserve(pqueue->vector, capacity);
+	vector_set_shrink(pqueue->vector, VECTOR_NO_SHRINK);
 
 	// If values != NULL, we initialize the heap with these values
 	if (values != NULL)
 		heapify(pqueue, values);
 
+	CHECK_INVARIANT(pqueue);
 	return pqueue;
 }
 
@@ -177,6 +226,7 @@ PriorityQueueNode* pqueue_insert(PriorityQueue* pqueue, void* value) {
 	// The inserted node can be greater than its parent
 	bubble_up(pqueue, inserted->id);
 
+	CHECK_INVARIANT(pqueue);
 	return inserted;
 }
 
@@ -194,12 +244,14 @@ void* pqueue_remove_max(PriorityQueue* pqueue) {
 	PriorityQueueNode* max_node = node_value(pqueue, last);
 	void* value_to_return = max_node->value;
 	vector_remove_last(pqueue->vector);
-	free(max_node); // free the memory allocated in insert
+	pqueue_node_release(pqueue, max_node); // the node can be reused by a next insert
 
 	// The new root can be smaller than one of its children
 	// Restoring the heap property
 	if (pqueue_size(pqueue) > 1)
 		bubble_down(pqueue, 1);
+
+	CHECK_INVARIANT(pqueue);
 	return value_to_return;
 }
 
@@ -218,6 +270,7 @@ void pqueue_destroy(PriorityQueue* pqueue) {
 		destroy_pq_node(to_delete);
 	}	
 	vector_destroy(pqueue->vector);
+	vector_destroy(pqueue->node_blocks);	// freeing all the nodes
 	free(pqueue);
 }
 void* pqueue_node_value(PriorityQueueNode* node) {
@@ -227,6 +280,7 @@ void* pqueue_node_value(PriorityQueueNode* node) {
 void pqueue_remove_node(PriorityQueue* pqueue, PriorityQueueNode* node) {
 	int last = pqueue_size(pqueue);
 	assert(last != 0);
+	assert(node->owner == pqueue && node_value(pqueue, node->id) == node);	// the node is in this pqueue
 
 	// Node is the root, so it's the max
 	if(node->id == 1) {
@@ -239,13 +293,17 @@ void pqueue_remove_node(PriorityQueue* pqueue, PriorityQueueNode* node) {
 		pqueue->destroy_value(node->value);
 	
 	// The node can be any node in the heap, so we swap it with the last one and remove the last one
-	node_swap(pqueue, node->id, last);
+	int node_id = node->id;
+	node_swap(pqueue, node_id, last);
 	vector_remove_last(pqueue->vector);
-	free(node);
+	pqueue_node_release(pqueue, node);
 
-	// The node can be smaller than any of its children, so we restore the heap property
-	if (pqueue_size(pqueue) > 1)
-		bubble_down(pqueue, 1);
+	// The last node, that took the place of the removed one, can be greater than its new parent
+	// or smaller than its new children, so we restore the heap property from that position
+	if (node_id < last)
+		pqueue_update_order(pqueue, node_value(pqueue, node_id));
+
+	CHECK_INVARIANT(pqueue);
 }
 
 void pqueue_update_order(PriorityQueue* pqueue, PriorityQueueNode* node) {
@@ -256,6 +314,34 @@ void pqueue_update_order(PriorityQueue* pqueue, PriorityQueueNode* node) {
 
 	// The node is smaller than its parent, but might be smaller than its children too, so its has to go down
 	bubble_down(pqueue, node->id);
+
+	CHECK_INVARIANT(pqueue);
+}
+
+void pqueue_increase_key(PriorityQueue* pqueue, PriorityQueueNode* node) {
+	// The node can only be greater than its parent now
+	bubble_up(pqueue, node->id);
+	CHECK_INVARIANT(pqueue);
+}
+
+void pqueue_decrease_key(PriorityQueue* pqueue, PriorityQueueNode* node) {
+	// The node can only be smaller than one of its children now
+	bubble_down(pqueue, node->id);
+	CHECK_INVARIANT(pqueue);
+}
+
+bool pqueue_check_invariant(PriorityQueue* pqueue) {
+	int size = pqueue_size(pqueue);
+	for (int id = 1; id <= size; id++) {
+		PriorityQueueNode* node = node_value(pqueue, id);
+
+		// every node knows its position and its owner, and it isn't greater than its parent
+		if (node->id != id || node->owner != pqueue)
+			return false;
+		if (id > 1 && compare_pq_nodes(node_value(pqueue, id / 2), node) < 0)
+			return false;
+	}
+	return true;
 }
 
 // function for handling the processes in the pq
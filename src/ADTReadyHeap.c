@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////
+// ADT ReadyHeap implementation using a 4-ary heap with
+// the keys stored inline in a contiguous array
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "ADTReadyHeap.h"
+#include "profile.h"
+
+// 4 children of 32 bytes each, and the heap is half as tall as a binary one. The children of position i are at bytes
+// 128i + 32 .. 128i + 160 of the array, so the array starts 32 bytes(one entry) before a cache line, and the children
+// of every node are exactly 2 cache lines, instead of 3 with a malloc'd array
+#define ARITY 4
+#define CACHE_LINE 64
+#define READY_HEAP_MIN_CAPACITY 16
+
+typedef struct ready_heap_entry {
+	int priority;
+	int pid;
+	double arrival_time;
+	void* value;
+	int handle;				// handle of the element, so that its position can be updated when it moves
+} Entry;
+
+// All positions are 0-based, the children of position i are ARITY*i + 1 .. ARITY*i + ARITY
+struct ready_heap {
+	Entry* entries;			// the heap, entries[1] starts a cache line
+	void* block;			// the allocation of entries, which starts a cache line
+	int size;
+	int capacity;
+
+	int* position;			// position[handle] = position of the element with that handle in entries
+	int* free_handles;		// stack of handles not used by any element
+	int free_count;
+	int handles;			// number of handles given till now
+	int handle_capacity;	// allocated size of position and free_handles
+};
+
+// true if a has to be before (closer to the root than) b
+static inline bool entry_before(const Entry* a, const Entry* b) {
+	if (a->priority != b->priority)
+		return a->priority < b->priority;
+	if (a->arrival_time != b->arrival_time)
+		return a->arrival_time < b->arrival_time;
+	return a->pid < b->pid;
+}
+
+// Places entry at position pos and updates the position of its handle
+static inline void place(ReadyHeap* heap, int pos, Entry* entry) {
+	heap->entries[pos] = *entry;
+	heap->position[entry->handle] = pos;
+}
+
+// The entry has to end up at position pos or above, so we move its ancestors down till we find its place
+static void sift_up(ReadyHeap* heap, int pos, Entry entry) {
+	while (pos > 0) {
+		int parent = (pos - 1) / ARITY;
+		if (!entry_before(&entry, &heap->entries[parent]))
+			break;
+		place(heap, pos, &heap->entries[parent]);
+		PROFILE_COUNT(COUNT_SIFT_STEPS);
+		pos = parent;
+	}
+	place(heap, pos, &entry);
+}
+
+// The entry has to end up at position pos or below, so we move its max children up till we find its place
+static void sift_down(ReadyHeap* heap, int pos, Entry entry) {
+	while (true) {
+		int first_child = ARITY * pos + 1;
+		if (first_child >= heap->size)
+			break;
+
+		// max of the children
+		int last_child = first_child + ARITY < heap->size ? first_child + ARITY : heap->size;
+		int max_child = first_child;
+		for (int child = first_child + 1; child < last_child; child++)
+			if (entry_before(&heap->entries[child], &heap->entries[max_child]))
+				max_child = child;
+
+		if (!entry_before(&heap->entries[max_child], &entry))
+			break;
+		place(heap, pos, &heap->entries[max_child]);
+		PROFILE_COUNT(COUNT_SIFT_STEPS);
+		pos = max_child;
+	}
+	place(heap, pos, &entry);
+}
+
+// Returns a handle for a new element
+static int handle_create(ReadyHeap* heap) {
+	if (heap->free_count != 0)
+		return heap->free_handles[--heap->free_count];
+
+	// all the handles are used, so we double the space for them
+	if (heap->handles == heap->handle_capacity) {
+		heap->handle_capacity *= 2;
+		heap->position = realloc(heap->position, heap->handle_capacity * sizeof(*heap->position));
+		heap->free_handles = realloc(heap->free_handles, heap->handle_capacity * sizeof(*heap->free_handles));
+		PROFILE_ADD(COUNT_ALLOCATIONS, 2);
+	}
+	return heap->handles++;
+}
+
+// Removes the entry at position pos
+static void remove_at(ReadyHeap* heap, int pos) {
+	heap->free_handles[heap->free_count++] = heap->entries[pos].handle;
+
+	// the last entry takes the place of the removed one, and it can go either up or down from there
+	heap->size--;
+	if (pos == heap->size)
+		return;
+
+	Entry last = heap->entries[heap->size];
+	if (pos > 0 && entry_before(&last, &heap->entries[(pos - 1) / ARITY]))
+		sift_up(heap, pos, last);
+	else
+		sift_down(heap, pos, last);
+}
+
+// Allocates the entries of the heap with capacity entries, copying its first size entries, and frees the old ones
+static void allocate_entries(ReadyHeap* heap, int capacity) {
+	size_t offset = CACHE_LINE - sizeof(Entry);
+	size_t bytes = (offset + capacity * sizeof(Entry) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;	// aligned_alloc wants whole cache lines
+	void* block = aligned_alloc(CACHE_LINE, bytes);
+	Entry* entries = (Entry*)((char*)block + offset);
+	if (heap->size != 0)
+		memcpy(entries, heap->entries, heap->size * sizeof(Entry));
+	free(heap->block);
+
+	heap->block = block;
+	heap->entries = entries;
+	heap->capacity = capacity;
+}
+
+//// ======================================= ADTReadyHeap ======================================= ////
+
+ReadyHeap* ready_heap_create(int capacity) {
+	ReadyHeap* heap = malloc(sizeof(*heap));
+	heap->size = 0;
+	heap->block = NULL;
+	allocate_entries(heap, capacity < READY_HEAP_MIN_CAPACITY ? READY_HEAP_MIN_CAPACITY : capacity);
+	heap->position = malloc(heap->capacity * sizeof(*heap->position));
+	heap->free_handles = malloc(heap->capacity * sizeof(*heap->free_handles));
+	heap->free_count = 0;
+	heap->handles = 0;
+	heap->handle_capacity = heap->capacity;
+	return heap;
+}
+
+int ready_heap_size(ReadyHeap* heap) { return heap->size; }
+
+void* ready_heap_max(ReadyHeap* heap) {
+	assert(heap->size != 0);
+	return heap->entries[0].value;
+}
+
+int ready_heap_insert(ReadyHeap* heap, int priority, double arrival_time, int pid, void* value) {
+	// If the array is full, we double its capacity
+	if (heap->size == heap->capacity) {
+		allocate_entries(heap, 2 * heap->capacity);
+		PROFILE_COUNT(COUNT_ALLOCATIONS);
+	}
+
+	Entry entry = { .priority = priority, .pid = pid, .arrival_time = arrival_time, .value = value, .handle = handle_create(heap) };
+
+	// the new entry starts from the end of the heap and goes up
+	heap->size++;
+	sift_up(heap, heap->size - 1, entry);
+	return entry.handle;
+}
+
+void* ready_heap_remove_max(ReadyHeap* heap) {
+	assert(heap->size != 0);
+
+	void* max = heap->entries[0].value;
+	remove_at(heap, 0);
+	return max;
+}
+
+void ready_heap_update_priority(ReadyHeap* heap, int handle, int priority) {
+	assert(handle >= 0 && handle < heap->handles);
+
+	// the entry goes up if its priority got higher, else down
+	int pos = heap->position[handle];
+	Entry entry = heap->entries[pos];
+	entry.priority = priority;
+	if (pos > 0 && entry_before(&entry, &heap->entries[(pos - 1) / ARITY]))
+		sift_up(heap, pos, entry);
+	else
+		sift_down(heap, pos, entry);
+}
+
+void ready_heap_remove(ReadyHeap* heap, int handle) {
+	assert(handle >= 0 && handle < heap->handles);
+	remove_at(heap, heap->position[handle]);
+}
+
+void ready_heap_destroy(ReadyHeap* heap) {
+	free(heap->block);
+	free(heap->position);
+	free(heap->free_handles);
+	free(heap);
+}
@@ -9,6 +9,7 @@
 #include <assert.h>
 
 #include "ADTVector.h"
+#include "profile.h"
 
 // The initial allocated size
 #define VECTOR_MIN_CAPACITY 10
@@ -22,15 +23,26 @@ struct vector {
 	VectorNode* array;			// Our data, array of struct vector_node
 	int capacity;				// Total allocated memory(when full, we increase it according to the growth factor "a")
 	int size;					// Number of inserted elements
+	int min_capacity;			// The array is never shrunk below it(VECTOR_MIN_CAPACITY, or the capacity of vector_reserve)
+	int shrink;					// The array is halved when less than 1/shrink of it is used, never if VECTOR_NO_SHRINK
 	DestroyFunc destroy_func;
 };
 
-// The vector is implemented using an array of VectorNodes and on every insert the array's capacity > GROWTH_FACTOR*size,
-// or else we reallocate space and copy all the elements of the array
+// Reallocates the array of vec for capacity elements
+static void vector_resize(Vector* vec, int capacity) {
+	vec->capacity = capacity;
+	vec->array = realloc(vec->array, vec->capacity * sizeof(*vec->array));	// realloc frees the old pointer
+	PROFILE_COUNT(COUNT_ALLOCATIONS);
+}
+
+// The vector is implemented using an array of VectorNodes, and when an insert finds it full
+// we reallocate space and copy all the elements of the array
 Vector* vector_create(int size, DestroyFunc destroy_value) {
 	Vector* vec = malloc(sizeof(*vec));
 	vec->size = size;
 	vec->destroy_func = destroy_value;
+	vec->min_capacity = VECTOR_MIN_CAPACITY;
+	vec->shrink = VECTOR_DEFAULT_SHRINK;
 
 	// Allocating space for the array. The vector has size not-initialized elements, but we allocate space for
 	// at least VECTOR_MIN_CAPACITY, to avoid too many array's resizes
@@ -42,6 +54,27 @@ Vector* vector_create(int size, DestroyFunc destroy_value) {
 
 int vector_size(Vector* vec) { return vec->size; }
 
+int vector_capacity(Vector* vec) { return vec->capacity; }
+
+void vector_reserve(Vector* vec, int capacity) {
+	if (capacity > vec->min_capacity)
+		vec->min_capacity = capacity;
+	if (capacity > vec->capacity)
+		vector_resize(vec, capacity);
+}
+
+void vector_shrink_to_fit(Vector* vec) {
+	vec->min_capacity = VECTOR_MIN_CAPACITY;
+	int capacity = vec->size < VECTOR_MIN_CAPACITY ? VECTOR_MIN_CAPACITY : vec->size;
+	if (capacity != vec->capacity)
+		vector_resize(vec, capacity);
+}
+
+void vector_set_shrink(Vector* vec, int shrink) {
+	assert(shrink == VECTOR_NO_SHRINK || shrink > GROWTH_FACTOR);
+	vec->shrink = shrink;
+}
+
 void* vector_get_at(Vector* vec, int pos) { 
 	assert(pos >= 0 && pos < vec->size);	// pos in [0, vec->size-1]
 
@@ -63,12 +96,10 @@ void vector_set_at(Vector* vec, int pos, void* value) {
 // vec->array is being resized 
 void vector_insert_last(Vector* vec, void* value) {
 	
-	// If the array's size has reached the maximum capacity, we resize it according to the growth_factor so that
+	// If the array is full, we resize it according to the growth_factor so that
 	// there's free space for future inserts, and the array is not resized each time (time-consuming)
-	if (vec->capacity == GROWTH_FACTOR*vec->size) {
-		vec->capacity *= GROWTH_FACTOR;
-		vec->array = realloc(vec->array, vec->capacity*sizeof(*vec->array));	// realloc frees the old pointer
-	}
+	if (vec->size == vec->capacity)
+		vector_resize(vec, vec->capacity * GROWTH_FACTOR);
 	// adding the new element in the array and updating vec's size
 	vec->array[vec->size].data = value;
 	vec->size++;
@@ -82,12 +113,11 @@ void vector_remove_last(Vector* vec) {
 	
 	vec->size--;
 	
-	// If only 1/(growth_factor*2) of the array's capacity is full, we resize the array to 1/growth_factor of its capacity
-	// so that we don't have too much memory waste, and there's still space for insert and remove.
-	if ((vec->capacity > vec->size * 2 * GROWTH_FACTOR) && (vec->capacity > VECTOR_MIN_CAPACITY * GROWTH_FACTOR)) {
-			vec->capacity /= GROWTH_FACTOR;
-			vec->array = realloc(vec->array, vec->capacity * sizeof(*vec->array));
-	}
+	// If less than 1/shrink of the array's capacity is full, we resize the array to 1/growth_factor of its capacity
+	// so that we don't have too much memory waste. shrink > growth_factor, so the halved array is still far from full,
+	// and a vector whose size goes up and down around a boundary isn't reallocated again and again
+	if (vec->shrink != VECTOR_NO_SHRINK && vec->size < vec->capacity / vec->shrink && vec->capacity / GROWTH_FACTOR >= vec->min_capacity)
+		vector_resize(vec, vec->capacity / GROWTH_FACTOR);
 }
 
 void* vector_find(Vector* vec, void* value, CompareFunc compare) {
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////
+// Aggregate implementation, with a log-linear histogram
+// whose bucket is found with a count of leading zeros
+///////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <math.h>
+#include "aggregate.h"
+
+// The percentiles of the report
+static const double percentiles[] = { 50, 90, 99, 99.9 };
+static const char* percentile_names[] = { "p50", "p90", "p99", "p999" };
+#define PERCENTILES (int)(sizeof(percentiles) / sizeof(percentiles[0]))
+
+// x >> (e - SUB_BITS) is the top SUB_BITS + 1 bits of x, in [SUB_BUCKETS, 2*SUB_BUCKETS), where e is the exponent of x
+// The value is rounded down, so that it's in [low, high) of its bucket, also when it's fractional(response, turnaround)
+static int bucket_of(double value) {
+	if (value >= (double)((uint64_t)1 << (AGGREGATE_MAX_EXPONENT + 1)))
+		return AGGREGATE_BUCKETS - 1;
+	uint64_t x = floor(value);
+	if (x < 2 * AGGREGATE_SUB_BUCKETS)
+		return x;
+	int e = 63 - __builtin_clzll(x);
+	return (e - AGGREGATE_SUB_BITS) * AGGREGATE_SUB_BUCKETS + (x >> (e - AGGREGATE_SUB_BITS));
+}
+
+double aggregate_bucket_low(int bucket) {
+	if (bucket < 2 * AGGREGATE_SUB_BUCKETS)
+		return bucket;
+	int e = bucket / AGGREGATE_SUB_BUCKETS + AGGREGATE_SUB_BITS - 1;
+	return ldexp(bucket % AGGREGATE_SUB_BUCKETS + AGGREGATE_SUB_BUCKETS, e - AGGREGATE_SUB_BITS);
+}
+
+double aggregate_bucket_high(int bucket) {
+	if (bucket == AGGREGATE_BUCKETS - 1)
+		return INFINITY;
+	return aggregate_bucket_low(bucket + 1);
+}
+
+void aggregate_init(Aggregate* aggregate) {
+	aggregate->count = 0;
+	aggregate->sum = 0;
+	aggregate->min = 0;
+	aggregate->max = 0;
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++)
+		aggregate->buckets[i] = 0;
+}
+
+void aggregate_add(Aggregate* aggregate, double value) {
+	if (aggregate->count == 0 || value < aggregate->min)
+		aggregate->min = value;
+	if (aggregate->count == 0 || value > aggregate->max)
+		aggregate->max = value;
+	aggregate->count++;
+	aggregate->sum += value;
+	aggregate->buckets[bucket_of(value)]++;
+}
+
+double aggregate_mean(Aggregate* aggregate) { return aggregate->count ? aggregate->sum / aggregate->count : 0.0; }
+
+double aggregate_percentile(Aggregate* aggregate, double percentile) {
+	if (aggregate->count == 0)
+		return 0;
+
+	// the value with that rank is in the first bucket where the cumulative count reaches it
+	long rank = ceil(percentile / 100 * aggregate->count), seen = 0;
+	if (rank < 1)
+		rank = 1;
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++) {
+		seen += aggregate->buckets[i];
+		if (seen >= rank) {
+			// the values of the bucket are below its high bound, whole slots or not
+			double high = aggregate_bucket_high(i);
+			return high < aggregate->max ? high : aggregate->max;
+		}
+	}
+	return aggregate->max;
+}
+
+void aggregate_print_histogram(Aggregate* aggregate, FILE* out) {
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++)
+		if (aggregate->buckets[i] != 0)
+			fprintf(out, " [%.0f, %.0f): %d", aggregate_bucket_low(i), aggregate_bucket_high(i), aggregate->buckets[i]);
+	fprintf(out, "\n");
+}
+
+void aggregate_write_json(Aggregate* aggregate, FILE* out) {
+	fprintf(out, "{\"count\": %ld, \"mean\": %.17g, \"min\": %.17g, \"max\": %.17g", aggregate->count, aggregate_mean(aggregate), aggregate->min, aggregate->max);
+	for (int p = 0; p < PERCENTILES; p++)
+		fprintf(out, ", \"%s\": %.17g", percentile_names[p], aggregate_percentile(aggregate, percentiles[p]));
+
+	// [low, high, count] of every non empty bucket, high is null for the last one
+	fprintf(out, ", \"buckets\": [");
+	const char* separator = "";
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++) {
+		if (aggregate->buckets[i] == 0)
+			continue;
+		if (i == AGGREGATE_BUCKETS - 1)
+			fprintf(out, "%s[%.0f, null, %d]", separator, aggregate_bucket_low(i), aggregate->buckets[i]);
+		else
+			fprintf(out, "%s[%.0f, %.0f, %d]", separator, aggregate_bucket_low(i), aggregate_bucket_high(i), aggregate->buckets[i]);
+		separator = ", ";
+	}
+	fprintf(out, "]}");
+}
+
+void aggregate_write_csv(Aggregate* aggregate, const char* prefix, FILE* out) {
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++)
+		if (aggregate->buckets[i] != 0)
+			fprintf(out, "%s,%.0f,%.0f,%d\n", prefix, aggregate_bucket_low(i), aggregate_bucket_high(i), aggregate->buckets[i]);
+}
@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////
+// Arrival source implementation, generating the processes
+// in batches, when the previous batch has arrived, or
+// reading them one by one from a workload file
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "arrival_source.h"
+#include "variates.h"
+
+#define GENERATOR_BATCH 1024	// processes generated at once
+#define GENERATOR_DRAWS 4		// random numbers drawn for every process: priority, arrival, lifetime, cs_time
+
+// Generator: the next GENERATOR_BATCH processes are generated at once, with the vectorized kernels of variates.h, from the
+// same uniforms and in the same order as if every process drew its own priority, arrival, lifetime and cs_time,
+// so the memory is only that of one batch and not of all the processes
+// Replay: the next process of the workload is read only when it's needed, so the file is never in memory as a whole
+struct arrival_source {
+	Workload* workload;	// NULL for a generator
+	int total_processes;
+	int produced;		// processes given out by arrival_source_next, the pid of the next one
+	double lambda_arrival;
+	double lambda_lifetime;
+	double lambda_cs_time;
+	double time;		// arrival_time of the last generated process
+	Rng rng;
+
+	// the current batch, processes [produced - batch_pos, produced - batch_pos + batch_size)
+	int batch_size;
+	int batch_pos;		// the next process of the batch
+	double* uniforms;	// the draws of every process are consecutive
+	double* batch_u;	// the same draw of every process of the batch
+	int* priorities;
+	double* arrival_times;
+	double* lifetimes;
+	double* cs_times;
+
+	// replay only
+	size_t workload_pos;	// position of the process after the pending one
+	WorkloadRecord pending;	// the next process, already read to find its arrival_time
+	bool has_pending;
+};
+
+ArrivalSource* arrival_source_create_generator(int total_processes, double lambda_arrival, double lambda_lifetime, double lambda_cs_time, Rng* rng) {
+	ArrivalSource* source = malloc(sizeof(*source));
+	source->workload = NULL;
+	source->total_processes = total_processes;
+	source->produced = 0;
+	source->lambda_arrival = lambda_arrival;
+	source->lambda_lifetime = lambda_lifetime;
+	source->lambda_cs_time = lambda_cs_time;
+	source->time = 0;
+	source->rng = *rng;
+
+	source->batch_size = 0;
+	source->batch_pos = 0;
+	source->uniforms = malloc(GENERATOR_DRAWS * GENERATOR_BATCH * sizeof(*source->uniforms));
+	source->batch_u = malloc(GENERATOR_BATCH * sizeof(*source->batch_u));
+	source->priorities = malloc(GENERATOR_BATCH * sizeof(*source->priorities));
+	source->arrival_times = malloc(GENERATOR_BATCH * sizeof(*source->arrival_times));
+	source->lifetimes = malloc(GENERATOR_BATCH * sizeof(*source->lifetimes));
+	source->cs_times = malloc(GENERATOR_BATCH * sizeof(*source->cs_times));
+	return source;
+}
+
+ArrivalSource* arrival_source_create_replay(Workload* workload) {
+	ArrivalSource* source = malloc(sizeof(*source));
+	source->workload = workload;
+	source->produced = 0;
+	source->time = 0;
+	source->workload_pos = 0;
+	source->has_pending = false;
+	return source;
+}
+
+// Replay: reads the next process of the workload, if it isn't read yet, and returns false if there are no more
+static bool read_pending(ArrivalSource* source) {
+	if (source->has_pending)
+		return true;
+	if (!workload_read(source->workload, &source->workload_pos, &source->pending))
+		return false;
+
+	// the processes have to arrive in the order of the file
+	if (source->pending.arrival_time < source->time) {
+		fprintf(stderr, "Error! workload: process %d arrives at %g, before the previous one(%g)\n", source->produced, source->pending.arrival_time, source->time);
+		exit(EXIT_FAILURE);
+	}
+	source->time = source->pending.arrival_time;
+	source->has_pending = true;
+	return true;
+}
+
+// generates the next batch of processes, after all the processes of the previous one have been given out
+static void generate_batch(ArrivalSource* source) {
+	int left = source->total_processes - source->produced;
+	int n = left < GENERATOR_BATCH ? left : GENERATOR_BATCH;
+	double* uniforms = source->uniforms, *batch_u = source->batch_u;
+	uniform_batch(&source->rng, uniforms, GENERATOR_DRAWS * n);
+
+	for (int i = 0; i < n; i++)
+		batch_u[i] = uniforms[GENERATOR_DRAWS * i];
+	uniform_int_batch(batch_u, source->priorities, n, 1, 7);
+
+	// the arrival time of each process = arrival_time of the previously created process("time" in our code)
+	// + the exponential time between 2 arrivals
+	for (int i = 0; i < n; i++)
+		batch_u[i] = uniforms[GENERATOR_DRAWS * i + 1];
+	exponential_batch(batch_u, source->arrival_times, n, source->lambda_arrival);
+	source->time = prefix_sum(source->arrival_times, source->arrival_times, n, source->time);
+
+	for (int i = 0; i < n; i++)
+		batch_u[i] = uniforms[GENERATOR_DRAWS * i + 2];
+	exponential_batch(batch_u, source->lifetimes, n, source->lambda_lifetime);
+
+	for (int i = 0; i < n; i++)
+		batch_u[i] = uniforms[GENERATOR_DRAWS * i + 3];
+	exponential_batch(batch_u, source->cs_times, n, source->lambda_cs_time);
+
+	source->batch_size = n;
+	source->batch_pos = 0;
+}
+
+Workload* arrival_source_generate_workload(int total_processes, double lambda_arrival, double lambda_lifetime, double lambda_cs_time, Rng* rng) {
+	ArrivalSource* source = arrival_source_create_generator(total_processes, lambda_arrival, lambda_lifetime, lambda_cs_time, rng);
+	WorkloadRecord* records = malloc(total_processes * sizeof(*records));
+
+	// the records are copied from the batches, with the lifetimes as they were drawn, so the replay adds the same arrival_times to them
+	while (source->produced < total_processes) {
+		generate_batch(source);
+		for (int i = 0; i < source->batch_size; i++) {
+			WorkloadRecord* record = &records[source->produced++];
+			record->arrival_time = source->arrival_times[i];
+			record->lifetime = source->lifetimes[i];
+			record->cs_time = source->cs_times[i];
+			record->priority = source->priorities[i];
+			record->reserved = 0;
+		}
+	}
+	arrival_source_destroy(source);
+	return workload_create(records, total_processes);
+}
+
+double arrival_source_peek(ArrivalSource* source) {
+	if (source->workload != NULL)
+		return read_pending(source) ? source->pending.arrival_time : INFINITY;
+
+	if (source->produced == source->total_processes)
+		return INFINITY;
+	if (source->batch_pos == source->batch_size)
+		generate_batch(source);
+	return source->arrival_times[source->batch_pos];
+}
+
+void arrival_source_next(ArrivalSource* source, Process* proc) {
+	if (source->workload != NULL) {
+		bool has_next = read_pending(source);
+		assert(has_next);
+		(void)has_next;
+		source->has_pending = false;
+
+		proc->priority = source->pending.priority;
+		proc->arrival_time = source->pending.arrival_time;
+		proc->lifetime = source->pending.lifetime + source->pending.arrival_time;
+		proc->cs_time = source->pending.cs_time;
+	}
+	else {
+		assert(source->produced < source->total_processes);
+		if (source->batch_pos == source->batch_size)
+			generate_batch(source);
+		int i = source->batch_pos++;
+
+		proc->priority = source->priorities[i];
+		proc->arrival_time = source->arrival_times[i];
+		proc->lifetime = source->lifetimes[i] + source->arrival_times[i];	// lifetime counts from the moment the process arrives
+		proc->cs_time = source->cs_times[i];
+	}
+
+	proc->pid = source->produced++;
+	proc->effective_priority = proc->priority;
+
+	proc->time_slots_running = 0;
+	proc->start_time = NOT_STARTED;
+	proc->end_time = 0;
+	proc->waiting_time = 0;
+	proc->blocked_time = 0;
+	proc->ready_since = 0;
+	proc->blocked_since = 0;
+
+	proc->cs_time_executed = 0;
+	proc->sem_alloc = NULL;
+	proc->expiry_node = NULL;
+	proc->wait_node = NULL;
+	proc->cpu = 0;
+}
+
+void arrival_source_destroy(ArrivalSource* source) {
+	if (source->workload != NULL) {
+		free(source);	// the workload belongs to the caller
+		return;
+	}
+	free(source->uniforms);
+	free(source->batch_u);
+	free(source->priorities);
+	free(source->arrival_times);
+	free(source->lifetimes);
+	free(source->cs_times);
+	free(source);
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////
+// Process table implementation, using blocks of records
+// that grow geometrically, and a free list of records
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <assert.h>
+#include "process_table.h"
+#include "ADTVector.h"
+#include "profile.h"
+
+#define TABLE_MIN_BLOCK 64	// records of the first block, every next block has as many records as all the previous ones
+#define MAX_BLOCKS 32		// enough blocks for more than INT_MAX records
+
+struct process_table {
+	Process* blocks[MAX_BLOCKS];
+	int num_blocks;
+	int capacity;		// records in all the blocks
+	int used;			// records of the blocks given out at least once, the next new record is the used-th one
+	int live;			// records given out and not released
+	Vector* free_list;	// released records, reused before any new one(LIFO, so the last released is still in the cache)
+};
+
+ProcessTable* process_table_create(void) {
+	ProcessTable* table = malloc(sizeof(*table));
+	table->num_blocks = 0;
+	table->capacity = 0;
+	table->used = 0;
+	table->live = 0;
+	table->free_list = vector_create(0, NULL);
+	vector_set_shrink(table->free_list, VECTOR_NO_SHRINK);	// it can't be bigger than the blocks, which aren't freed either
+	return table;
+}
+
+Process* process_table_alloc(ProcessTable* table) {
+	table->live++;
+
+	// a released record
+	int free_size = vector_size(table->free_list);
+	if (free_size != 0) {
+		Process* proc = vector_get_at(table->free_list, free_size - 1);
+		vector_remove_last(table->free_list);
+		return proc;
+	}
+
+	// all the blocks are used, so a new one is allocated, doubling the capacity
+	if (table->used == table->capacity) {
+		assert(table->num_blocks < MAX_BLOCKS);
+		int block_size = table->capacity == 0 ? TABLE_MIN_BLOCK : table->capacity;
+		table->blocks[table->num_blocks++] = malloc(block_size * sizeof(Process));
+		PROFILE_COUNT(COUNT_ALLOCATIONS);
+		table->capacity += block_size;
+	}
+
+	// the first unused record of the last block
+	Process* last_block = table->blocks[table->num_blocks - 1];
+	int last_block_start = table->num_blocks == 1 ? 0 : table->capacity / 2;
+	return &last_block[table->used++ - last_block_start];
+}
+
+void process_table_release(ProcessTable* table, Process* proc) {
+	assert(table->live > 0);
+	table->live--;
+	vector_insert_last(table->free_list, proc);
+}
+
+int process_table_live(ProcessTable* table) { return table->live; }
+
+int process_table_capacity(ProcessTable* table) { return table->capacity; }
+
+void process_table_destroy(ProcessTable* table) {
+	for (int i = 0; i < table->num_blocks; i++)
+		free(table->blocks[i]);
+	vector_destroy(table->free_list);
+	free(table);
+}
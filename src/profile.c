@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////
+// Profile implementation, the clock and the report
+///////////////////////////////////////////////////////////
+
+#include <time.h>
+#include "profile.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+_Thread_local Profile profile_data;
+
+static const char* phase_names[PHASES] = { "arrivals", "lifetime checks", "work stealing", "scheduling", "semaphores", "trace", "waiting accounting", "cs stretches", "run stretches" };
+static const char* counter_names[COUNTERS] = { "slots", "heap sift steps", "preemptions", "blocks", "semaphore acquisitions", "allocations" };
+
+uint64_t profile_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+const char* profile_unit(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	return "cycles";
+#else
+	return "ns";
+#endif
+}
+
+void profile_print(Profile* profile, FILE* out) {
+#ifndef PROFILE
+	fprintf(out, "Profile: not compiled in, build with -DPROFILE in the CFLAGS\n");
+	(void)profile;
+	(void)phase_names;
+	(void)counter_names;
+#else
+	uint64_t phases_total = 0;
+	fprintf(out, "Profile of the main loop: %llu %s\n", (unsigned long long)profile->total, profile_unit());
+	for (int p = 0; p < PHASES; p++) {
+		phases_total += profile->time[p];
+		fprintf(out, "%-20s %14llu %s %6.2f%% %12llu calls %10.1f %s/call\n", phase_names[p], (unsigned long long)profile->time[p], profile_unit(),
+				profile->total ? 100.0 * profile->time[p] / profile->total : 0.0, (unsigned long long)profile->calls[p],
+				profile->calls[p] ? (double)profile->time[p] / profile->calls[p] : 0.0, profile_unit());
+	}
+
+	// the rest: the loop itself, the idle jumps of the event-driven mode, and the timers
+	uint64_t rest = profile->total > phases_total ? profile->total - phases_total : 0;
+	fprintf(out, "%-20s %14llu %s %6.2f%%\n", "other", (unsigned long long)rest, profile_unit(), profile->total ? 100.0 * rest / profile->total : 0.0);
+	for (int c = 0; c < COUNTERS; c++)
+		fprintf(out, "%-24s %14llu\n", counter_names[c], (unsigned long long)profile->counters[c]);
+#endif
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////
+// Ready queue implementation, forwarding every operation
+// to the implementation selected at its creation
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include "ready_queue.h"
+#include "ADTReadyHeap.h"
+#include "ADTMultilevelQueue.h"
+
+#define PRIORITY_LEVELS 7	// priorities of the processes are 1..7
+
+struct ready_queue {
+	ReadyQueueType type;
+	PriorityQueue* pqueue;		// READY_PQUEUE
+	ReadyHeap* heap;			// READY_HEAP
+	MultilevelQueue* multilevel;	// READY_MULTILEVEL
+};
+
+ReadyQueue* ready_queue_create(ReadyQueueType type, CompareFunc compare, int capacity) {
+	ReadyQueue* ready_queue = malloc(sizeof(*ready_queue));
+	ready_queue->type = type;
+	ready_queue->pqueue = type == READY_PQUEUE ? pqueue_create(compare, NULL, NULL, capacity) : NULL;
+	ready_queue->heap = type == READY_HEAP ? ready_heap_create(capacity) : NULL;
+	ready_queue->multilevel = type == READY_MULTILEVEL ? multilevel_create(PRIORITY_LEVELS, capacity) : NULL;
+	return ready_queue;
+}
+
+int ready_queue_size(ReadyQueue* ready_queue) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:	return pqueue_size(ready_queue->pqueue);
+		case READY_HEAP:	return ready_heap_size(ready_queue->heap);
+		case READY_MULTILEVEL:	return multilevel_size(ready_queue->multilevel);
+	}
+	return 0;
+}
+
+void* ready_queue_max(ReadyQueue* ready_queue) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:	return pqueue_max(ready_queue->pqueue);
+		case READY_HEAP:	return ready_heap_max(ready_queue->heap);
+		case READY_MULTILEVEL:	return multilevel_max(ready_queue->multilevel);
+	}
+	return NULL;
+}
+
+ReadyHandle ready_queue_insert(ReadyQueue* ready_queue, int priority, double arrival_time, int pid, void* value) {
+	ReadyHandle handle = { .node = NULL };
+	switch (ready_queue->type) {
+		case READY_PQUEUE:
+			handle.node = pqueue_insert(ready_queue->pqueue, value);
+			break;
+		case READY_HEAP:
+			handle.id = ready_heap_insert(ready_queue->heap, priority, arrival_time, pid, value);
+			break;
+		case READY_MULTILEVEL:
+			handle.id = multilevel_insert(ready_queue->multilevel, priority, arrival_time, pid, value);
+			break;
+	}
+	return handle;
+}
+
+void ready_queue_update_priority(ReadyQueue* ready_queue, ReadyHandle handle, int priority) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:
+			pqueue_update_order(ready_queue->pqueue, handle.node);
+			break;
+		case READY_HEAP:
+			ready_heap_update_priority(ready_queue->heap, handle.id, priority);
+			break;
+		case READY_MULTILEVEL:
+			multilevel_update_priority(ready_queue->multilevel, handle.id, priority);
+			break;
+	}
+}
+
+void* ready_queue_remove_max(ReadyQueue* ready_queue) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:	return pqueue_remove_max(ready_queue->pqueue);
+		case READY_HEAP:	return ready_heap_remove_max(ready_queue->heap);
+		case READY_MULTILEVEL:	return multilevel_remove_max(ready_queue->multilevel);
+	}
+	return NULL;
+}
+
+void ready_queue_remove(ReadyQueue* ready_queue, ReadyHandle handle) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:
+			pqueue_remove_node(ready_queue->pqueue, handle.node);
+			break;
+		case READY_HEAP:
+			ready_heap_remove(ready_queue->heap, handle.id);
+			break;
+		case READY_MULTILEVEL:
+			multilevel_remove(ready_queue->multilevel, handle.id);
+			break;
+	}
+}
+
+void ready_queue_destroy(ReadyQueue* ready_queue) {
+	switch (ready_queue->type) {
+		case READY_PQUEUE:
+			pqueue_destroy(ready_queue->pqueue);
+			break;
+		case READY_HEAP:
+			ready_heap_destroy(ready_queue->heap);
+			break;
+		case READY_MULTILEVEL:
+			multilevel_destroy(ready_queue->multilevel);
+			break;
+	}
+	free(ready_queue);
+}
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////
+// Replications implementation, using a pool of threads
+// that take the next replication to run from a counter
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include "replication.h"
+#include "common_types.h"
+
+// Shared by the threads of the pool. Only next is changed by them, with the mutex locked, and every
+// simulation writes only to its own stats
+typedef struct replication_pool {
+	SimulationParams** params;	// params[i] of simulation i
+	SimulationStats* stats;
+	Rng* streams;			// streams[i] of simulation i
+	int simulations;
+	int next;				// next simulation to run
+	pthread_mutex_t mutex;
+} ReplicationPool;
+
+// Every thread runs simulations till there is no one left
+static void* replication_worker(void* arg) {
+	ReplicationPool* pool = arg;
+
+	while (true) {
+		pthread_mutex_lock(&pool->mutex);
+		int i = pool->next++;
+		pthread_mutex_unlock(&pool->mutex);
+
+		if (i >= pool->simulations)
+			return NULL;
+
+		simulate(pool->params[i], &pool->streams[i], NULL, NULL, &pool->stats[i]);
+	}
+}
+
+void replication_streams(uint64_t seed, int replications, Rng* streams) {
+	// the streams are jumped one after the other, so that each one costs a single jump
+	rng_seed(&streams[0], seed);
+	for (int i = 1; i < replications; i++) {
+		streams[i] = streams[i - 1];
+		rng_long_jump(&streams[i]);
+	}
+}
+
+void run_simulations(SimulationParams** params, Rng* streams, int simulations, int threads, SimulationStats* stats) {
+	ReplicationPool pool = { .params = params, .stats = stats, .streams = streams, .simulations = simulations, .next = 0 };
+	pthread_mutex_init(&pool.mutex, NULL);
+
+	for (int i = 0; i < simulations; i++)
+		stats[i].busy_slots = malloc(params[i]->cpus * sizeof(*stats[i].busy_slots));
+
+	if (threads > simulations)
+		threads = simulations;
+	pthread_t* workers = malloc(threads * sizeof(*workers));
+	for (int t = 0; t < threads; t++)
+		if (pthread_create(&workers[t], NULL, replication_worker, &pool) != 0)
+			error_exit("replications: pthread_create failed");
+	for (int t = 0; t < threads; t++)
+		pthread_join(workers[t], NULL);
+
+	free(workers);
+	pthread_mutex_destroy(&pool.mutex);
+}
+
+void run_replications(SimulationParams* params, int replications, int threads, uint64_t seed, SimulationStats* stats) {
+	Rng* streams = malloc(replications * sizeof(*streams));
+	SimulationParams** replication_params = malloc(replications * sizeof(*replication_params));
+	replication_streams(seed, replications, streams);
+	for (int i = 0; i < replications; i++)
+		replication_params[i] = params;
+
+	run_simulations(replication_params, streams, replications, threads, stats);
+	free(replication_params);
+	free(streams);
+}
+
+// 0.975 quantile of the Student's t distribution with df degrees of freedom, for the 95% confidence interval
+static double t_quantile(int df) {
+	static const double quantiles[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+										2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+										2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+	if (df <= 30)
+		return quantiles[df - 1];
+	return 1.960;	// close enough to the normal distribution
+}
+
+void mean_ci(double* values, int n, double* mean, double* half_width) {
+	double sum = 0, sum_sq = 0;
+	for (int i = 0; i < n; i++)
+		sum += values[i];
+	*mean = sum / n;
+
+	if (n < 2) {
+		*half_width = NAN;	// a single value has no variance
+		return;
+	}
+	for (int i = 0; i < n; i++)
+		sum_sq += (values[i] - *mean) * (values[i] - *mean);
+	*half_width = t_quantile(n - 1) * sqrt(sum_sq / (n - 1)) / sqrt(n);
+}
+
+#define CI_LENGTH 32
+
+// The half width of a confidence interval as it's printed, in buf, or n/a if there isn't any(a single replication)
+static const char* ci_string(double half_width, char* buf) {
+	if (isnan(half_width))
+		return "n/a";
+	snprintf(buf, CI_LENGTH, "%.2f", half_width);
+	return buf;
+}
+
+void print_replication_stats(SimulationStats* stats, int replications, int cpus) {
+	double* values = malloc(replications * sizeof(*values));	// the same stat of every replication
+	double mean[4], half_width[4];
+	char ci[4][CI_LENGTH];
+
+	printf("Mean and 95%% confidence interval of %d replications:\n", replications);
+	for (int p = 0; p < PRIORITIES; p++) {
+		for (int i = 0; i < replications; i++)
+			values[i] = stats[i].waiting_time_slots[p];
+		mean_ci(values, replications, &mean[0], &half_width[0]);
+		for (int i = 0; i < replications; i++)
+			values[i] = stats[i].blocked_time_slots[p];
+		mean_ci(values, replications, &mean[1], &half_width[1]);
+		for (int i = 0; i < replications; i++)
+			values[i] = stats[i].running_time_slots[p];
+		mean_ci(values, replications, &mean[2], &half_width[2]);
+		for (int i = 0; i < replications; i++)
+			values[i] = stats[i].cs_time_slots[p];
+		mean_ci(values, replications, &mean[3], &half_width[3]);
+
+		printf("Waiting for: %.2f +/- %s, Blocked for: %.2f +/- %s, Running for: %.2f +/- %s, Critical section for: %.2f +/- %s time slots for processes with priority: %d\n",
+			   mean[0], ci_string(half_width[0], ci[0]), mean[1], ci_string(half_width[1], ci[1]), mean[2], ci_string(half_width[2], ci[2]),
+			   mean[3], ci_string(half_width[3], ci[3]), p + 1);
+	}
+
+	// and of the finished processes, their number, mean turnaround and its 99th percentile in every replication
+	for (int p = 0; p < PRIORITIES; p++) {
+		for (int i = 0; i < replications; i++)
+			values[i] = stats[i].turnaround[p].count;
+		mean_ci(values, replications, &mean[0], &half_width[0]);
+		for (int i = 0; i < replications; i++)
+			values[i] = aggregate_mean(&stats[i].turnaround[p]);
+		mean_ci(values, replications, &mean[1], &half_width[1]);
+		for (int i = 0; i < replications; i++)
+			values[i] = aggregate_percentile(&stats[i].turnaround[p], 99);
+		mean_ci(values, replications, &mean[2], &half_width[2]);
+
+		printf("Finished: %.2f +/- %s processes, Turnaround: %.2f +/- %s, Turnaround p99: %.2f +/- %s time slots for processes with priority: %d\n",
+			   mean[0], ci_string(half_width[0], ci[0]), mean[1], ci_string(half_width[1], ci[1]), mean[2], ci_string(half_width[2], ci[2]), p + 1);
+	}
+
+	// and the utilization of each cpu, in the multi-cpu mode
+	if (cpus > 1) {
+		for (int c = 0; c < cpus; c++) {
+			for (int i = 0; i < replications; i++)
+				values[i] = stats[i].total_slots ? 100.0 * stats[i].busy_slots[c] / stats[i].total_slots : 0.0;
+			mean_ci(values, replications, &mean[0], &half_width[0]);
+			if (isnan(half_width[0]))
+				printf("Utilization: %.2f%% +/- n/a for cpu: %d\n", mean[0], c);
+			else
+				printf("Utilization: %.2f%% +/- %.2f%% for cpu: %d\n", mean[0], half_width[0], c);
+		}
+	}
+	free(values);
+}
+
+void compare_protocols(SimulationParams* params, int replications, int threads, uint64_t seed) {
+	const SemProtocol protocols[] = { SEM_PROTOCOL_NONE, SEM_PROTOCOL_INHERITANCE, SEM_PROTOCOL_CEILING };
+	SimulationStats* stats[3];
+	SimulationParams protocol_params = *params;
+	protocol_params.sem_queues = true;		// the protocols work on the wait queues of the semaphores
+
+	for (int i = 0; i < 3; i++) {
+		protocol_params.sem_protocol = protocols[i];
+		stats[i] = malloc(replications * sizeof(*stats[i]));
+		run_replications(&protocol_params, replications, threads, seed, stats[i]);
+	}
+
+	// replication r of every protocol has the same processes, so the saved blocked time is the mean of the differences
+	double* values = malloc(replications * sizeof(*values));
+	double mean[5], half_width[5];
+	char ci[5][CI_LENGTH];
+	printf("Blocked time with each --sem-protocol, mean and 95%% confidence interval of %d replications:\n", replications);
+	printf("All of them with the semaphore wait queues(--sem-queues), so None is the queued model without a protocol, not the default spinning one\n");
+	for (int p = 0; p < PRIORITIES; p++) {
+		for (int i = 0; i < 3; i++) {
+			for (int r = 0; r < replications; r++)
+				values[r] = stats[i][r].blocked_time_slots[p];
+			mean_ci(values, replications, &mean[i], &half_width[i]);
+		}
+		for (int i = 1; i < 3; i++) {
+			for (int r = 0; r < replications; r++)
+				values[r] = stats[0][r].blocked_time_slots[p] - stats[i][r].blocked_time_slots[p];
+			mean_ci(values, replications, &mean[i + 2], &half_width[i + 2]);
+		}
+
+		printf("None(--sem-queues): %.2f +/- %s, Inheritance: %.2f +/- %s (saves %.2f +/- %s, %.2f%%), Ceiling: %.2f +/- %s (saves %.2f +/- %s, %.2f%%) blocked time slots for processes with priority: %d\n",
+			   mean[0], ci_string(half_width[0], ci[0]), mean[1], ci_string(half_width[1], ci[1]), mean[3], ci_string(half_width[3], ci[3]),
+			   mean[0] ? 100 * mean[3] / mean[0] : 0.0, mean[2], ci_string(half_width[2], ci[2]), mean[4], ci_string(half_width[4], ci[4]),
+			   mean[0] ? 100 * mean[4] / mean[0] : 0.0, p + 1);
+	}
+
+	// and the tail of the blocked time of a process
+	for (int p = 0; p < PRIORITIES; p++) {
+		for (int i = 0; i < 3; i++) {
+			for (int r = 0; r < replications; r++)
+				values[r] = aggregate_percentile(&stats[i][r].blocked[p], 99);
+			mean_ci(values, replications, &mean[i], &half_width[i]);
+		}
+		printf("Blocked p99: None(--sem-queues): %.2f +/- %s, Inheritance: %.2f +/- %s, Ceiling: %.2f +/- %s time slots for processes with priority: %d\n",
+			   mean[0], ci_string(half_width[0], ci[0]), mean[1], ci_string(half_width[1], ci[1]), mean[2], ci_string(half_width[2], ci[2]), p + 1);
+	}
+
+	free(values);
+	for (int i = 0; i < 3; i++)
+		destroy_replication_stats(stats[i], replications);
+}
+
+void destroy_replication_stats(SimulationStats* stats, int replications) {
+	for (int i = 0; i < replications; i++)
+		free(stats[i].busy_slots);
+	free(stats);
+}
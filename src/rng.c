@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////
+// Random number generator implementation, xoshiro256**
+// (Blackman & Vigna), seeded with splitmix64
+///////////////////////////////////////////////////////////
+
+#include "rng.h"
+
+// splitmix64, only for the seeding, since its outputs are well spread even for seeds like 0, 1, 2..
+static uint64_t splitmix64(uint64_t* x) {
+	uint64_t z = (*x += 0x9e3779b97f4a7c15);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+	return z ^ (z >> 31);
+}
+
+void rng_seed(Rng* rng, uint64_t seed) {
+	for (int i = 0; i < 4; i++)
+		rng->s[i] = splitmix64(&seed);
+}
+
+// Advances rng by the polynomial given in jump, the same as calling rng_next() that many times
+static void rng_jump_by(Rng* rng, const uint64_t jump[4]) {
+	uint64_t s[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 4; i++) {
+		for (int b = 0; b < 64; b++) {
+			if (jump[i] & ((uint64_t)1 << b)) {
+				for (int j = 0; j < 4; j++)
+					s[j] ^= rng->s[j];
+			}
+			rng_next(rng);
+		}
+	}
+	for (int j = 0; j < 4; j++)
+		rng->s[j] = s[j];
+}
+
+void rng_jump(Rng* rng) {
+	static const uint64_t jump[4] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+	rng_jump_by(rng, jump);
+}
+
+void rng_long_jump(Rng* rng) {
+	static const uint64_t long_jump[4] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+	rng_jump_by(rng, long_jump);
+}
@@ -1,31 +1,89 @@
 #include <stdlib.h>
 #include "../include/semaphore.h"
 #include "common_types.h"
+#include "profile.h"
 
 struct semaphore {
 	int semid;
-	// pid of process using this semaphore at the CS.. used_by_pid = -1 if it's not used 
-	int used_by_pid;	// else used_by_pid = pid of the process that is currently using it
+	int count;		// units of the semaphore
+	// the processes using this semaphore at the CS, holders[0]..holders[used - 1]. used = 0 if it's not used
+	int used;
+	void** holders;
+	PriorityQueue* waiters;	// the processes blocked on the semaphore, the highest priority one at the top
 };
 
-Semaphore* create_semaphores(int S) {
+Semaphore* create_semaphores(int S, int count, CompareFunc waiter_compare) {
 	Semaphore* sem_set = malloc(S*sizeof(*sem_set)); // mem allocation for set of semaphores
 	for (int i = 0; i < S; i++) {
 		sem_set[i] = malloc(sizeof(*sem_set[i])); 	 // mem allocation for each semaphore
 		sem_set[i]->semid = i;						 // and initializing
-		sem_set[i]->used_by_pid = -1;				 // not used by any process initially
+		sem_set[i]->count = count;
+		sem_set[i]->used = 0;						 // not used by any process initially
+		sem_set[i]->holders = malloc(count * sizeof(*sem_set[i]->holders));
+		sem_set[i]->waiters = pqueue_create(waiter_compare, NULL, NULL, 0);
 	}
 	return sem_set;
 }
 
 void destroy_semaphores(Semaphore* sem_set, int S) {
-	for(int i = 0; i < S; ++i)
+	for(int i = 0; i < S; ++i) {
+		free(sem_set[i]->holders);
+		pqueue_destroy(sem_set[i]->waiters);	// the blocked processes belong to the simulation
 		free(sem_set[i]);	// deallocating the memory for each semaphore
+	}
 	free(sem_set); 			// deallocating the memory for the set of semaphore itself
 }
 
-void sem_down(Semaphore sem, int pid) { sem->used_by_pid = pid; }
+// position of proc in the holders, -1 if it doesn't hold a unit. The count of a semaphore is small, so it's just a scan
+static int holder_index(Semaphore sem, void* proc) {
+	for (int i = 0; i < sem->used; i++)
+		if (sem->holders[i] == proc)
+			return i;
+	return -1;
+}
+
+bool sem_try_down(Semaphore sem, void* proc) {
+	if (holder_index(sem, proc) != -1)	// it already holds it, from a previous slot
+		return true;
+	if (sem->used == sem->count)
+		return false;
+	sem->holders[sem->used++] = proc;
+	PROFILE_COUNT(COUNT_SEM_ACQUIRES);
+	return true;
+}
+
+void* sem_up(Semaphore sem, void* proc) {
+	int i = holder_index(sem, proc);
+	if (i == -1)
+		return NULL;
+
+	// nobody waits, so the unit is free again
+	if (pqueue_size(sem->waiters) == 0) {
+		sem->holders[i] = sem->holders[--sem->used];
+		return NULL;
+	}
+
+	// else the unit goes straight to the highest priority waiter, so no other process can take it in between
+	void* waiter = pqueue_remove_max(sem->waiters);
+	sem->holders[i] = waiter;
+	PROFILE_COUNT(COUNT_SEM_ACQUIRES);
+	return waiter;
+}
+
+bool sem_holds(Semaphore sem, void* proc) { return holder_index(sem, proc) != -1; }
+
+int sem_used(Semaphore sem) { return sem->used; }
+
+void* sem_holder(Semaphore sem, int i) { return sem->holders[i]; }
+
+PriorityQueueNode* sem_wait(Semaphore sem, void* proc) { return pqueue_insert(sem->waiters, proc); }
+
+void sem_cancel_wait(Semaphore sem, PriorityQueueNode* node) { pqueue_remove_node(sem->waiters, node); }
+
+int sem_waiters(Semaphore sem) { return pqueue_size(sem->waiters); }
+
+void* sem_max_waiter(Semaphore sem) { return pqueue_max(sem->waiters); }
 
-void sem_up(Semaphore sem) { sem->used_by_pid = -1; }
+void sem_update_waiter(Semaphore sem, PriorityQueueNode* node) { pqueue_update_order(sem->waiters, node); }
 
-int sem_used_by_process(Semaphore sem) { return sem->used_by_pid; }
\ No newline at end of file
+int sem_id(Semaphore sem) { return sem->semid; }
\ No newline at end of file
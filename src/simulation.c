@@ -0,0 +1,927 @@
+///////////////////////////////////////////////////////////
+// Simulation implementation, the processes, the cpus and
+// the semaphores of one run of the simulator(simulate()),
+// and the printing of its results
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <limits.h>
+#include "../include/semaphore.h"
+#include "common_types.h"
+#include "ADTPriorityQueue.h"
+#include "trace.h"
+#include "ready_queue.h"
+#include "process_table.h"
+#include "simulation.h"
+#include "arrival_source.h"
+#include "profile.h"
+
+//// ======================================================== P R O C E S S ======================================================== ////
+// compare based first on priority, then on arrival time, and then on pid
+// The priority is the effective one, raised by the --sem-protocol while the process holds a semaphore
+// The arrival times are compared as they are, and not as their truncated difference, so that no two processes are equal
+// and every implementation of the ready_pq agrees on its max process
+int ready_pq_compare(void *a, void *b)
+{
+    int to_return = (((Process*)b)->effective_priority - ((Process*)a)->effective_priority);
+	if (to_return == 0 && ((Process*)a)->arrival_time != ((Process*)b)->arrival_time)
+		return ((Process*)a)->arrival_time < ((Process*)b)->arrival_time ? 1 : -1;
+	if (to_return == 0)
+		return (((Process*)b)->pid - ((Process*)a)->pid);
+    return to_return;
+}
+
+// compare based first on lifetime, and then on pid
+int expiry_pq_compare(void *a, void *b) {
+	double a_lifetime = ((Process*)a)->lifetime, b_lifetime = ((Process*)b)->lifetime;
+	if (a_lifetime != b_lifetime)
+		return a_lifetime < b_lifetime ? 1 : -1;	// the process that passes its lifetime first is the max
+	return (((Process*)b)->pid - ((Process*)a)->pid);
+}
+
+double rand_exponential(double lambda, Rng* rng) { return -log(1.0 - rng_double(rng))/lambda; }
+
+int rand_uniform(int low, int high, Rng* rng) {
+	int range = high - low +1;
+	double rand_var = rng_double(rng);
+	return (rand_var*range) + low;
+}
+
+// Function for processes ~~ waiting ~~ in the ready_pq to be executed, for "slots" time slots
+// Only the per priority totals are incremented, according to the number of ready processes of each priority.
+// The waiting_time of each process is settled when it leaves the ready_pq(settle_waiting_time)
+void incr_proc_waiting_time(int* ready_count, int* waiting_time_slots, int slots) {
+	for (int i = 0; i < 7; i++)
+		waiting_time_slots[i] += ready_count[i] * slots;
+}
+
+// The process leaves the ready_pq, so it has been waiting from the slot it entered it till the current one
+void settle_waiting_time(Process* proc, int* ready_count, int current_time) {
+	proc->waiting_time += current_time - proc->ready_since;
+	ready_count[proc->priority - 1]--;
+}
+
+// Function for processes ~~ blocked ~~ in the wait queues of the semaphores(--sem-queues), for "slots" time slots
+// Like the waiting time, only the per priority totals are incremented, and the blocked_time of each process is settled when it's woken
+void incr_proc_blocked_time(int* blocked_count, int* blocked_time_slots, int slots) {
+	for (int i = 0; i < 7; i++)
+		blocked_time_slots[i] += blocked_count[i] * slots;
+}
+
+// The process leaves the wait queue of its semaphore, so it has been blocked from the slot it was blocked till the current one
+void settle_blocked_time(Process* proc, int* blocked_count, int current_time) {
+	proc->blocked_time += current_time - proc->blocked_since;
+	blocked_count[proc->priority - 1]--;
+	proc->wait_node = NULL;
+}
+
+// Every process of the ready_pq is in the expiry_pq too, ordered by lifetime, so that the processes that are
+// not alive any more are found at its top, without visiting the whole ready_pq
+// inserts proc into the ready_pq of the cpu and the expiry_pq, where it starts waiting from the current time slot
+void ready_pq_insert(ReadyQueue** ready_pqs, int cpu, PriorityQueue* expiry_pq, Process* proc, int* ready_count, int current_time) {
+	proc->ready_handle = ready_queue_insert(ready_pqs[cpu], proc->effective_priority, proc->arrival_time, proc->pid, proc);
+	proc->cpu = cpu;
+	proc->expiry_node = pqueue_insert(expiry_pq, proc);
+	proc->ready_since = current_time;
+	ready_count[proc->priority - 1]++;
+}
+
+// removes the process with the highest priority from the ready_pq and the expiry_pq and returns it
+Process* ready_pq_remove_max(ReadyQueue* ready_pq, PriorityQueue* expiry_pq, int* ready_count, int current_time) {
+	Process* proc = ready_queue_remove_max(ready_pq);
+	pqueue_remove_node(expiry_pq, proc->expiry_node);
+	settle_waiting_time(proc, ready_count, current_time);
+	proc->expiry_node = NULL;
+	return proc;
+}
+
+// The process passed its lifetime, so if it is in its CS it's forced to up(), it's added to the aggregates of its priority
+// and to the completion_log, and it's released from the table. Nothing else of it is kept
+// Returns the process blocked on its semaphore that is handed the semaphore(--sem-queues), which has to be woken, or NULL
+Process* process_finished(Process* proc, ProcessTable* processes_pool, SimulationStats* stats, FILE* completion_log, int current_time) {
+	Process* woken = NULL;
+	int i = proc->priority - 1;
+	proc->end_time = current_time;
+	if (proc->start_time != NOT_STARTED)		// it got a cpu
+		aggregate_add(&stats->response[i], proc->start_time - proc->arrival_time);
+	aggregate_add(&stats->turnaround[i], proc->end_time - proc->arrival_time);
+	aggregate_add(&stats->waiting[i], proc->waiting_time);
+	aggregate_add(&stats->blocked[i], proc->blocked_time);
+	if (completion_log != NULL)
+		fprintf(completion_log, "%d,%d,%.17g,%d,%d,%.17g,%d,%d,%d\n", proc->pid, proc->priority, proc->arrival_time, proc->start_time,
+				proc->end_time, proc->end_time - proc->arrival_time, proc->waiting_time, proc->blocked_time, proc->time_slots_running);
+
+	// if the process is at its CS, force up()
+	if (proc->sem_alloc != NULL) {
+		// running its CS rn, else sem_up() does nothing
+		woken = sem_up(proc->sem_alloc, proc);
+
+		proc->sem_alloc = NULL;
+	}
+	process_table_release(processes_pool, proc);
+	return woken;
+}
+
+int arrival_cpu(Process* proc, Process** running, ReadyQueue** ready_pqs, int cpus, bool sem_queues);
+
+// The priority the process is scheduled with(--sem-protocol): its own, raised while it holds a semaphore to the highest
+// priority of the processes blocked on the semaphore(inheritance), or to the ceiling of the semaphore(ceiling)
+int protocol_priority(Process* proc, SemProtocol protocol) {
+	int priority = proc->priority;
+	if ((protocol == SEM_PROTOCOL_NONE) || (proc->sem_alloc == NULL) || !sem_holds(proc->sem_alloc, proc))
+		return priority;
+
+	if ((protocol == SEM_PROTOCOL_CEILING) && (SEM_CEILING < priority))
+		return SEM_CEILING;
+	if ((protocol == SEM_PROTOCOL_INHERITANCE) && (sem_waiters(proc->sem_alloc) != 0)) {
+		int inherited = ((Process*)sem_max_waiter(proc->sem_alloc))->effective_priority;
+		if (inherited < priority)
+			return inherited;
+	}
+	return priority;
+}
+
+void inherit_priority(Semaphore sem, ReadyQueue** ready_pqs, SemProtocol protocol);
+
+// Sets the effective priority of the process again, and moves it to its new position in its ready_pq or wait queue.
+// If it's blocked, its new priority is passed on to the holders of the semaphore it waits for, so the inheritance
+// goes through the whole chain of blocked holders
+void update_effective_priority(Process* proc, ReadyQueue** ready_pqs, SemProtocol protocol) {
+	int priority = protocol_priority(proc, protocol);
+	if (priority == proc->effective_priority)
+		return;
+
+	proc->effective_priority = priority;
+	if (proc->wait_node != NULL) {
+		sem_update_waiter(proc->sem_alloc, proc->wait_node);
+		inherit_priority(proc->sem_alloc, ready_pqs, protocol);
+	}
+	else if (proc->expiry_node != NULL)		// it's in a ready_pq, else it's running and nothing has to move
+		ready_queue_update_priority(ready_pqs[proc->cpu], proc->ready_handle, priority);
+}
+
+// The processes blocked on sem changed, so with the inheritance protocol its holders inherit the priority of the highest one
+void inherit_priority(Semaphore sem, ReadyQueue** ready_pqs, SemProtocol protocol) {
+	if (protocol != SEM_PROTOCOL_INHERITANCE)
+		return;
+	for (int i = 0; i < sem_used(sem); i++)
+		update_effective_priority(sem_holder(sem, i), ready_pqs, protocol);
+}
+
+// The process is handed the semaphore it was blocked on(--sem-queues), so it goes back to a ready_pq, already in its CS,
+// to the cpu where it can run the soonest, like an arriving process
+void wake_process(Process* proc, Process** running, ReadyQueue** ready_pqs, int cpus, PriorityQueue* expiry_pq, int* ready_count, int* blocked_count,
+				  SemProtocol protocol, int current_time) {
+	settle_blocked_time(proc, blocked_count, current_time);
+	pqueue_remove_node(expiry_pq, proc->expiry_node);	// ready_pq_insert() inserts it again
+	proc->effective_priority = protocol_priority(proc, protocol);
+	ready_pq_insert(ready_pqs, arrival_cpu(proc, running, ready_pqs, cpus, true), expiry_pq, proc, ready_count, current_time);
+	inherit_priority(proc->sem_alloc, ready_pqs, protocol);		// the other holders, of a counting semaphore, lost a waiter
+}
+
+// The running process attempted to enter its CS, but all the units of the semaphore are used(--sem-queues), so it leaves
+// the cpu and waits in the wait queue of the semaphore, till it's handed the semaphore or it passes its lifetime.
+// It's in the expiry_pq while it's blocked, like the processes of the ready_pqs
+void block_process(Process* proc, ReadyQueue** ready_pqs, PriorityQueue* expiry_pq, int* blocked_count, SemProtocol protocol, int current_time) {
+	proc->wait_node = sem_wait(proc->sem_alloc, proc);
+	proc->expiry_node = pqueue_insert(expiry_pq, proc);
+	proc->blocked_since = current_time;
+	blocked_count[proc->priority - 1]++;
+	PROFILE_COUNT(COUNT_BLOCKS);
+	inherit_priority(proc->sem_alloc, ready_pqs, protocol);
+}
+
+// checking if any process is not alive any more, except for the ones that are already running (that's a seperate check)
+// The expiry_pq has the processes of the ready_pqs of all the cpus, and the ones blocked on a semaphore
+// O(klogn) for the k processes that passed their lifetime
+void checkIfAnyProcessPassedItsLifetime(ReadyQueue** ready_pqs, Process** running, int cpus, PriorityQueue* expiry_pq, ProcessTable* processes_pool, SimulationStats* stats,
+										FILE* completion_log, int* ready_count, int* blocked_count, SemProtocol protocol, int current_time) {
+	Process* prob_fin_proc;		// probably_finished_process
+
+	while ((pqueue_size(expiry_pq) != 0) && (prob_fin_proc = pqueue_max(expiry_pq)) && (prob_fin_proc->lifetime <= current_time)) {
+		pqueue_remove_max(expiry_pq);
+		if (prob_fin_proc->wait_node != NULL) {		// blocked on its semaphore
+			sem_cancel_wait(prob_fin_proc->sem_alloc, prob_fin_proc->wait_node);
+			settle_blocked_time(prob_fin_proc, blocked_count, current_time);
+			inherit_priority(prob_fin_proc->sem_alloc, ready_pqs, protocol);	// its holders don't inherit its priority any more
+		}
+		else {
+			ready_queue_remove(ready_pqs[prob_fin_proc->cpu], prob_fin_proc->ready_handle);
+			settle_waiting_time(prob_fin_proc, ready_count, current_time);
+		}
+		prob_fin_proc->expiry_node = NULL;
+		Process* woken = process_finished(prob_fin_proc, processes_pool, stats, completion_log, current_time);	// it's finished
+		if (woken != NULL)
+			wake_process(woken, running, ready_pqs, cpus, expiry_pq, ready_count, blocked_count, protocol, current_time);	// checked by this loop too
+	}
+}
+
+// ======================================= Event-driven mode ======================================= //
+// A slot-stepped run and an event-driven run go through exactly the same slots, but in the event-driven mode
+// the stretches of slots in which the state of the system can't change are not simulated one by one:
+// - idle stretches, where nothing runs and nothing is ready, until the next arrival
+// - stretches where the running process just continues its CS, until its CS is done, the next arrival
+//   or the next lifetime expiry (the only points where a preemption can happen)
+// - stretches where the running process runs out of its CS and doesn't attempt to enter it, until the slot
+//   where it attempts, the next arrival or the next lifetime expiry
+// All the stretches consume the random numbers in the same order as the slotted loop, so the stats are the same.
+// Only a single cpu is simulated in stretches. With -c the cpus affect each other every slot(arrival_cpu, steal_work),
+// so only the idle stretches are skipped, and every other slot is simulated one by one.
+
+// first time slot in which the event at time "time" is visible, since every check is "time <= curr_time"
+int event_slot(double time) { return time > INT_MAX ? INT_MAX : (int)ceil(time); }
+
+// first time slot in which the next process of the source arrives, or INT_MAX if there isn't any
+int next_arrival_slot(ArrivalSource* arrivals) { return event_slot(arrival_source_peek(arrivals)); }
+
+// first time slot in which a process of the ready_pq passes its lifetime, or INT_MAX if the ready_pq is empty
+int next_ready_expiry_slot(PriorityQueue* expiry_pq) {
+	if (pqueue_size(expiry_pq) == 0)
+		return INT_MAX;
+	return event_slot(((Process*)pqueue_max(expiry_pq))->lifetime);
+}
+
+bool preemptible(Process* proc, bool sem_queues);
+
+// Returns the number of slots, starting from current_time, in which the curr_proc_running only continues its CS.
+// 0 if the next slot can change the state of the system and has to be simulated normally.
+int cs_stretch_length(Process* curr_proc_running, ReadyQueue* ready_pq, ArrivalSource* arrivals, PriorityQueue* expiry_pq, int current_time, bool sem_queues) {
+	// not in a CS that it holds the semaphore for
+	if ((curr_proc_running == NULL) || (curr_proc_running->sem_alloc == NULL) || !sem_holds(curr_proc_running->sem_alloc, curr_proc_running))
+		return 0;
+
+	// a higher priority process is gonna preempt it(--sem-queues), in the next slot
+	if (preemptible(curr_proc_running, sem_queues) && (ready_queue_size(ready_pq) != 0) && (((Process*)ready_queue_max(ready_pq))->effective_priority < curr_proc_running->effective_priority))
+		return 0;
+
+	// slots left till cs_time_executed reaches cs_time
+	int horizon = event_slot(curr_proc_running->cs_time) - curr_proc_running->cs_time_executed;
+
+	// the stretch ends at the next arrival or lifetime expiry
+	int next_event = next_arrival_slot(arrivals);
+	int slot = event_slot(curr_proc_running->lifetime);
+	if (slot < next_event)
+		next_event = slot;
+	slot = next_ready_expiry_slot(expiry_pq);
+	if (slot < next_event)
+		next_event = slot;
+
+	if (next_event - current_time < horizon)
+		horizon = next_event - current_time;
+	return horizon > 0 ? horizon : 0;
+}
+
+// Returns the number of slots, starting from current_time, in which the curr_proc_running can only run out of its CS,
+// or attempt to enter it(the first one that attempts ends the stretch, see run_out_of_cs_stretch).
+// 0 if the next slot can change the state of the system otherwise and has to be simulated normally.
+int out_of_cs_stretch_length(Process* curr_proc_running, ReadyQueue* ready_pq, ArrivalSource* arrivals, PriorityQueue* expiry_pq, int current_time) {
+	// in its CS, blocked on its semaphore, or exiting its CS in the next slot
+	if ((curr_proc_running == NULL) || (curr_proc_running->sem_alloc != NULL) || (curr_proc_running->cs_time_executed >= curr_proc_running->cs_time))
+		return 0;
+
+	// a higher priority process is gonna preempt it, in the next slot
+	if ((ready_queue_size(ready_pq) != 0) && (((Process*)ready_queue_max(ready_pq))->effective_priority < curr_proc_running->effective_priority))
+		return 0;
+
+	// the stretch ends at the next arrival or lifetime expiry
+	int next_event = next_arrival_slot(arrivals);
+	int slot = event_slot(curr_proc_running->lifetime);
+	if (slot < next_event)
+		next_event = slot;
+	slot = next_ready_expiry_slot(expiry_pq);
+	if (slot < next_event)
+		next_event = slot;
+	return next_event > current_time ? next_event - current_time : 0;
+}
+
+// Runs at once up to "slots" time slots, in which the curr_proc_running runs out of its CS, exactly as the slotted loop would.
+// The random numbers of every slot are drawn first, and if the process attempts to enter its CS in that slot, the rng
+// goes back to its state before them, so that the slot is simulated normally. Returns the slots run
+int run_out_of_cs_stretch(Process* curr_proc_running, ReadyQueue* ready_pq, int* ready_count, int* blocked_count, int current_time, int slots, int k, bool sem_queues, Rng* rng,
+						  int* blocked_time_slots, int* running_time_slots, int* waiting_time_slots, Trace* running_state_trace) {
+	// the competitor doesn't change during the stretch and draws its probability every slot, but without a CS to be
+	// blocked by, nothing else happens to it. With --sem-queues only the running process draws
+	Process* competitor_proc = !sem_queues && (ready_queue_size(ready_pq) != 0) ? ready_queue_max(ready_pq) : NULL;
+
+	int run = 0;
+	for (; run < slots; run++) {
+		Rng before = *rng;
+		if (competitor_proc != NULL)
+			competitor_proc->cs_enter_probability = rand_uniform(0, 100, rng);
+		curr_proc_running->cs_enter_probability = rand_uniform(0, 100, rng);
+		if (curr_proc_running->cs_enter_probability >= k) {
+			*rng = before;
+			break;
+		}
+		curr_proc_running->time_slots_running++;
+		trace_running(running_state_trace, current_time + run, curr_proc_running->pid, curr_proc_running->time_slots_running, -1);
+	}
+
+	incr_proc_waiting_time(ready_count, waiting_time_slots, run);
+	incr_proc_blocked_time(blocked_count, blocked_time_slots, run);
+	running_time_slots[curr_proc_running->priority - 1] += run;
+	return run;
+}
+
+// id of the semaphore the process holds while running, -1 if it doesn't hold any
+int running_semid(Process* proc) {
+	if ((proc->sem_alloc == NULL) || !sem_holds(proc->sem_alloc, proc))
+		return -1;
+	return sem_id(proc->sem_alloc);
+}
+
+// Runs at once "slots" time slots, in which the curr_proc_running continues its CS, exactly as the slotted loop would
+void run_cs_stretch(Process* curr_proc_running, ReadyQueue* ready_pq, int* ready_count, int* blocked_count, int current_time, int slots, int k, bool sem_queues, Rng* rng,
+					int* blocked_time_slots, int* cs_time_slots, int* running_time_slots, int* waiting_time_slots, Trace* running_state_trace) {
+
+	// the competitor doesn't change during the stretch and attempts to enter its CS every slot, but it's blocked.
+	// With --sem-queues only a running process attempts to enter its CS, so the competitor just waits
+	if (!sem_queues && (ready_queue_size(ready_pq) != 0)) {
+		Process* competitor_proc = ready_queue_max(ready_pq);
+		for (int i = 0; i < slots; i++) {
+			competitor_proc->cs_enter_probability = rand_uniform(0, 100, rng);
+			if (competitor_proc->cs_enter_probability >= k) {
+				competitor_proc->blocked_time++;
+				blocked_time_slots[competitor_proc->priority - 1]++;
+				PROFILE_COUNT(COUNT_BLOCKS);
+			}
+		}
+	}
+	incr_proc_waiting_time(ready_count, waiting_time_slots, slots);
+	incr_proc_blocked_time(blocked_count, blocked_time_slots, slots);
+
+	curr_proc_running->cs_time_executed += slots;
+	cs_time_slots[curr_proc_running->priority - 1] += slots;
+	running_time_slots[curr_proc_running->priority - 1] += slots;
+
+	// the running state is still traced for every slot, unless tracing is disabled
+	if (running_state_trace == NULL) {
+		curr_proc_running->time_slots_running += slots;
+		return;
+	}
+	int semid = running_semid(curr_proc_running);
+	for (int i = 0; i < slots; i++) {
+		curr_proc_running->time_slots_running++;
+		trace_running(running_state_trace, current_time + i, curr_proc_running->pid, curr_proc_running->time_slots_running, semid);
+	}
+}
+
+// ======================================= Multi-cpu mode ======================================= //
+// With -c <cpus> every cpu has its own running process and its own ready_pq, and the processes are spread among them:
+// - an arriving process goes to the cpu where it can run the soonest(arrival_cpu)
+// - a waiting process that can't run on its own cpu is stolen by a cpu where it can(steal_work)
+// - then every cpu decides on its own which process runs on it, exactly like a single cpu
+// The semaphores are shared by all the cpus, so a process that attempts to enter its CS while the semaphore is used
+// by a process running on another cpu, is blocked and doesn't run till the semaphore is available.
+// The expiry_pq and the per priority stats are common for all the cpus.
+
+// the process running on a cpu can be preempted, only if it doesn't hold a semaphore.
+// With --sem-queues it can always be preempted, and it keeps its semaphore while it waits
+bool preemptible(Process* proc, bool sem_queues) { return sem_queues || (running_semid(proc) == -1); }
+
+// true if nothing runs or waits on any cpu
+bool cpus_idle(Process** running, ReadyQueue** ready_pqs, int cpus) {
+	for (int c = 0; c < cpus; c++)
+		if ((running[c] != NULL) || (ready_queue_size(ready_pqs[c]) != 0))
+			return false;
+	return true;
+}
+
+// Chooses the cpu whose ready_pq the arriving proc goes to:
+// - an idle cpu, with nothing running or waiting, if there is one
+// - else the cpu running the lowest priority process that can be preempted, if proc has a higher priority, so that it runs now
+// - else the cpu with the fewest waiting processes
+int arrival_cpu(Process* proc, Process** running, ReadyQueue** ready_pqs, int cpus, bool sem_queues) {
+	int victim = -1, shortest = 0;
+	for (int c = 0; c < cpus; c++) {
+		if ((running[c] == NULL) && (ready_queue_size(ready_pqs[c]) == 0))
+			return c;
+		if ((running[c] != NULL) && preemptible(running[c], sem_queues) && ((victim == -1) || (running[c]->effective_priority > running[victim]->effective_priority)))
+			victim = c;
+		if (ready_queue_size(ready_pqs[c]) < ready_queue_size(ready_pqs[shortest]))
+			shortest = c;
+	}
+	if ((victim != -1) && (proc->effective_priority < running[victim]->effective_priority))
+		return victim;
+	return shortest;
+}
+
+// Priority-aware work stealing, every slot before the cpus decide which process runs on them.
+// A cpu steals the highest priority process waiting on another cpu, that can't run there in this slot(the process running
+// there holds a semaphore, or has a higher or equal priority), but would run on this one(it's idle, or it runs a lower
+// priority process that can be preempted, and no higher priority process waits in its own ready_pq).
+// The stolen process keeps waiting from the slot it entered the first ready_pq, and its place in the expiry_pq
+void steal_work(Process** running, ReadyQueue** ready_pqs, int cpus, bool sem_queues) {
+	for (int c = 0; c < cpus; c++) {
+		Process* candidate = NULL;
+		int victim = -1;
+		for (int v = 0; v < cpus; v++) {
+			if ((v == c) || (ready_queue_size(ready_pqs[v]) == 0))
+				continue;
+
+			// the max of the ready_pq of v is gonna run on v
+			Process* proc = ready_queue_max(ready_pqs[v]);
+			if ((running[v] == NULL) || (preemptible(running[v], sem_queues) && (proc->effective_priority < running[v]->effective_priority)))
+				continue;
+
+			if ((candidate == NULL) || (ready_pq_compare(proc, candidate) > 0)) {
+				candidate = proc;
+				victim = v;
+			}
+		}
+		if (candidate == NULL)
+			continue;
+
+		// it wouldn't run on this cpu either
+		if ((running[c] != NULL) && (!preemptible(running[c], sem_queues) || (candidate->effective_priority >= running[c]->effective_priority)))
+			continue;
+		if ((ready_queue_size(ready_pqs[c]) != 0) && (ready_pq_compare(ready_queue_max(ready_pqs[c]), candidate) > 0))
+			continue;
+
+		ready_queue_remove(ready_pqs[victim], candidate->ready_handle);
+		candidate->ready_handle = ready_queue_insert(ready_pqs[c], candidate->effective_priority, candidate->arrival_time, candidate->pid, candidate);
+		candidate->cpu = c;
+	}
+}
+
+// ======================================= Semaphore wait queues ======================================= //
+// With --sem-queues a process that attempts to enter its CS while all the units of the semaphore are used, is blocked:
+// it leaves the cpu and waits in the wait queue of the semaphore, ordered by priority, and the cpu runs the next ready
+// process in the same slot. When a process exits its CS, or passes its lifetime in it, its unit is handed directly to the
+// highest priority waiter, which goes back to a ready_pq already in its CS. Only the running processes attempt to enter
+// their CS, and a process in its CS can be preempted, keeping its semaphore. So the blocked processes cost nothing
+// while they wait, only when they are blocked and when they are woken.
+
+// cpu c decides which process runs on it in this slot, and returns it, NULL if nothing can run
+Process* schedule_queued(int c, Process** running, ReadyQueue** ready_pqs, int cpus, PriorityQueue* expiry_pq, Semaphore* sem_set, int S, int k, SemProtocol protocol,
+						 Rng* rng, int* ready_count, int* blocked_count, SimulationStats* stats, Trace* running_state_trace, int current_time) {
+	Process* curr_proc_running = running[c];
+	ReadyQueue* ready_pq = ready_pqs[c];
+
+	// the highest priority process takes the cpu, even if the running one is in its CS
+	PROFILE_START(PHASE_SCHEDULING);
+	if ((curr_proc_running != NULL) && (ready_queue_size(ready_pq) != 0) && (((Process*)ready_queue_max(ready_pq))->effective_priority < curr_proc_running->effective_priority)) {
+		Process* competitor_proc = ready_pq_remove_max(ready_pq, expiry_pq, ready_count, current_time);
+		ready_pq_insert(ready_pqs, c, expiry_pq, curr_proc_running, ready_count, current_time);	// it waits with its semaphore, if it has one
+		curr_proc_running = competitor_proc;
+		PROFILE_COUNT(COUNT_PREEMPTIONS);
+		if (curr_proc_running->start_time == NOT_STARTED)
+			curr_proc_running->start_time = current_time;
+	}
+	PROFILE_END(PHASE_SCHEDULING);
+
+	// till a process runs in this slot, since a blocked one leaves the cpu to the next one
+	while (true) {
+		if (curr_proc_running == NULL) {
+			if (ready_queue_size(ready_pq) == 0)
+				return NULL;
+			curr_proc_running = ready_pq_remove_max(ready_pq, expiry_pq, ready_count, current_time);
+			if (curr_proc_running->start_time == NOT_STARTED)
+				curr_proc_running->start_time = current_time;
+		}
+
+		PROFILE_START(PHASE_SEMAPHORES);
+		// not done with its CS yet, or not having entered its CS yet
+		if (curr_proc_running->cs_time_executed < curr_proc_running->cs_time) {
+			// enters its CS with a probability, if it isn't in it already(it may have been handed the semaphore while blocked)
+			if (curr_proc_running->sem_alloc == NULL) {
+				curr_proc_running->cs_enter_probability = rand_uniform(0, 100, rng);
+				if (curr_proc_running->cs_enter_probability >= k) {
+					curr_proc_running->sem_alloc = sem_set[rand_uniform(1, S, rng) - 1];
+					if (!sem_try_down(curr_proc_running->sem_alloc, curr_proc_running)) {
+						block_process(curr_proc_running, ready_pqs, expiry_pq, blocked_count, protocol, current_time);
+						curr_proc_running = NULL;
+						PROFILE_END(PHASE_SEMAPHORES);
+						continue;
+					}
+					curr_proc_running->effective_priority = protocol_priority(curr_proc_running, protocol);	// the ceiling, if any
+				}
+			}
+			if (curr_proc_running->sem_alloc != NULL) {
+				curr_proc_running->cs_time_executed++;
+				stats->cs_time_slots[curr_proc_running->priority - 1]++;
+			}
+		}
+		// its CS is done, so the semaphore goes to the highest priority process blocked on it
+		else {
+			if (curr_proc_running->sem_alloc != NULL) {
+				running[c] = curr_proc_running;	// so that the woken process isn't sent to this cpu as if it was idle
+				Process* woken = sem_up(curr_proc_running->sem_alloc, curr_proc_running);
+				if (woken != NULL)
+					wake_process(woken, running, ready_pqs, cpus, expiry_pq, ready_count, blocked_count, protocol, current_time);
+			}
+			curr_proc_running->cs_time_executed = 0;	// initializing for a possible entry to the CS again
+			curr_proc_running->sem_alloc = NULL;
+			curr_proc_running->effective_priority = curr_proc_running->priority;	// it doesn't inherit any priority out of its CS
+		}
+		PROFILE_END(PHASE_SEMAPHORES);
+		break;
+	}
+
+	curr_proc_running->time_slots_running++;
+	stats->running_time_slots[curr_proc_running->priority - 1]++;
+	stats->busy_slots[c]++;
+
+	PROFILE_START(PHASE_TRACE);
+	trace_running(running_state_trace, current_time, curr_proc_running->pid, curr_proc_running->time_slots_running, running_semid(curr_proc_running));
+	PROFILE_END(PHASE_TRACE);
+	return curr_proc_running;
+}
+
+// deallocating memory 
+void free_resources(ArrivalSource* arrivals, ReadyQueue** ready_pqueues, int cpus, PriorityQueue* expiry_pqueue, ProcessTable* processes_pool, Semaphore* sem_set, int S) {
+	arrival_source_destroy(arrivals);
+	for (int c = 0; c < cpus; c++)
+		ready_queue_destroy(ready_pqueues[c]);
+	free(ready_pqueues);
+	pqueue_destroy(expiry_pqueue);
+	process_table_destroy(processes_pool);	// the finished processes are already released, and the table deallocates all its records at once
+	destroy_semaphores(sem_set, S);
+}
+//// ========================================================  S I M U L A T O R  ======================================================== ////
+
+// Runs one simulation, everything it uses is local to it
+void simulate(SimulationParams* params, Rng* stream, Trace* running_state_trace, FILE* completion_log, SimulationStats* stats) {
+	int k = params->k, S = params->S, cpus = params->cpus;
+	bool event_driven = params->event_driven, sem_queues = params->sem_queues;
+	int* running_time_slots = stats->running_time_slots; // time slots for each of the 7 sets of priority processes..priority-1based : running_time_slots[0]..priority-2based : running_time_slots[1], etc
+	int* waiting_time_slots = stats->waiting_time_slots;
+	int* blocked_time_slots = stats->blocked_time_slots;
+	int* cs_time_slots = stats->cs_time_slots;
+	int* busy_slots = stats->busy_slots;	// time slots in which each cpu was running a process
+	int ready_count[7];	// number of processes of each priority in the ready_pqueues
+	int blocked_count[7];	// number of processes of each priority in the wait queues of the semaphores(--sem-queues)
+	int curr_time = 0;
+	Process** running;	// the process running on each cpu, NULL if the cpu is idle
+	Semaphore* sem_set;
+	PriorityQueue* expiry_pqueue;
+	ProcessTable* processes_pool;	// the processes that have arrived and are still alive
+	ArrivalSource* arrivals;	// the processes that haven't arrived yet, produced just before they arrive
+	ReadyQueue** ready_pqueues;	// the ready_pqueue of each cpu
+
+	// The processes are generated from the stream of the simulation, and the scheduling decisions are drawn from an
+	// independent stream, so the same seed gives the same processes whatever the scheduling options are
+	Rng workload_rng = *stream;
+	Rng scheduling_rng = *stream;
+	rng_jump(&scheduling_rng);
+	Rng* rng = &scheduling_rng;
+
+	// initialization
+	for (int i = 0; i < 7; i++) {
+		running_time_slots[i] = 0;
+		waiting_time_slots[i] = 0;
+		blocked_time_slots[i] = 0;
+		cs_time_slots[i] = 0;
+		ready_count[i] = 0;
+		blocked_count[i] = 0;
+		aggregate_init(&stats->response[i]);
+		aggregate_init(&stats->turnaround[i]);
+		aggregate_init(&stats->waiting[i]);
+		aggregate_init(&stats->blocked[i]);
+	}
+
+	sem_set = create_semaphores(S, params->sem_count, ready_pq_compare);	// the blocked processes are woken in the order they would run
+	processes_pool = process_table_create();
+	if (params->workload != NULL)
+		arrivals = arrival_source_create_replay(params->workload);
+	else
+		arrivals = arrival_source_create_generator(params->total_processes, params->lambda_arrival, params->lambda_lifetime, params->lambda_cs_time, &workload_rng);
+	// The queues are created with memory for the processes alive at the same time on average(lambda_arrival/lambda_lifetime,
+	// by Little's law), so they are reallocated only by the peaks. Unknown for a workload, so they start small
+	int expected_alive = 0;
+	if (params->workload == NULL && params->lambda_lifetime > 0)
+		expected_alive = fmin(params->lambda_arrival / params->lambda_lifetime, params->total_processes);
+	running = malloc(cpus * sizeof(*running));
+	ready_pqueues = malloc(cpus * sizeof(*ready_pqueues));
+	for (int c = 0; c < cpus; c++) {
+		running[c] = NULL;
+		busy_slots[c] = 0;
+		ready_pqueues[c] = ready_queue_create(params->ready_queue_type, ready_pq_compare, expected_alive / cpus);	// all processes that have arrived, and wait to run on cpu c
+	}
+	expiry_pqueue = pqueue_create(expiry_pq_compare, NULL, NULL, expected_alive);	// the processes of the ready_pqueue, ordered by lifetime
+
+	// while there are still processes to arrive, or alive ones
+	// a time slot is this while loop
+	PROFILE_TOTAL_START();
+	while ((arrival_source_peek(arrivals) != INFINITY) || (process_table_live(processes_pool) != 0)) {
+		Process* proc_insert, *competitor_proc;
+
+		if (event_driven) {
+			// nothing is running or waiting, so we jump to the slot of the next arrival
+			if (cpus_idle(running, ready_pqueues, cpus) && (next_arrival_slot(arrivals) != INT_MAX) && (next_arrival_slot(arrivals) > curr_time))
+				curr_time = next_arrival_slot(arrivals);
+
+			// the process running on the single cpu just continues its CS till the next event, so we run all these slots at once
+			int slots = cpus == 1 ? cs_stretch_length(running[0], ready_pqueues[0], arrivals, expiry_pqueue, curr_time, sem_queues) : 0;
+			if (slots > 0) {
+				PROFILE_START(PHASE_CS_STRETCH);
+				run_cs_stretch(running[0], ready_pqueues[0], ready_count, blocked_count, curr_time, slots, k, sem_queues, rng, blocked_time_slots, cs_time_slots, running_time_slots, waiting_time_slots, running_state_trace);
+				PROFILE_END(PHASE_CS_STRETCH);
+				busy_slots[0] += slots;
+				curr_time += slots;
+				continue;
+			}
+
+			// or it runs out of its CS till it attempts to enter it, or till the next event
+			slots = cpus == 1 ? out_of_cs_stretch_length(running[0], ready_pqueues[0], arrivals, expiry_pqueue, curr_time) : 0;
+			if (slots > 0) {
+				PROFILE_START(PHASE_RUN_STRETCH);
+				slots = run_out_of_cs_stretch(running[0], ready_pqueues[0], ready_count, blocked_count, curr_time, slots, k, sem_queues, rng, blocked_time_slots, running_time_slots, waiting_time_slots, running_state_trace);
+				PROFILE_END(PHASE_RUN_STRETCH);
+				busy_slots[0] += slots;
+				curr_time += slots;
+			}
+		}
+
+		PROFILE_COUNT(COUNT_SLOTS);
+
+		// obtains the first arrived processes from the source and inserts them into the ready_pqueue of the cpu they can run the soonest
+		PROFILE_START(PHASE_ARRIVALS);
+		while (arrival_source_peek(arrivals) <= curr_time) {
+			proc_insert = process_table_alloc(processes_pool);
+			arrival_source_next(arrivals, proc_insert);
+			ready_pq_insert(ready_pqueues, arrival_cpu(proc_insert, running, ready_pqueues, cpus, sem_queues), expiry_pqueue, proc_insert, ready_count, curr_time);
+		}
+		PROFILE_END(PHASE_ARRIVALS);
+
+		// the current processes that are not alive any more
+		PROFILE_START(PHASE_EXPIRY);
+		for (int c = 0; c < cpus; c++) {
+			Process* curr_proc_running = running[c];
+			if ((curr_proc_running != NULL) && (curr_proc_running->lifetime <= curr_time)) {
+				// printing the running state of the process to an external file
+				trace_finishing(running_state_trace, curr_time, curr_proc_running->pid);
+
+				running[c] = NULL;
+				Process* woken = process_finished(curr_proc_running, processes_pool, stats, completion_log, curr_time);
+				if (woken != NULL)
+					wake_process(woken, running, ready_pqueues, cpus, expiry_pqueue, ready_count, blocked_count, params->sem_protocol, curr_time);
+			}
+		}
+
+		// before extracting the max_process from ready_pq:
+		// checks for non alive processes in the ready_pqueues, where they are all supposed to be alive
+		// and if there exist, it takes them out of the ready_pq and releases them, every time slot passing by
+		checkIfAnyProcessPassedItsLifetime(ready_pqueues, running, cpus, expiry_pqueue, processes_pool, stats, completion_log, ready_count, blocked_count, params->sem_protocol, curr_time);
+		PROFILE_END(PHASE_EXPIRY);
+
+		// the processes that can't run on their cpu, move to a cpu where they can
+		if (cpus > 1) {
+			PROFILE_START(PHASE_STEALING);
+			steal_work(running, ready_pqueues, cpus, sem_queues);
+			PROFILE_END(PHASE_STEALING);
+		}
+
+		// every cpu decides which process runs on it, in this slot
+		for (int c = 0; c < cpus; c++) {
+			if (sem_queues) {
+				running[c] = schedule_queued(c, running, ready_pqueues, cpus, expiry_pqueue, sem_set, S, k, params->sem_protocol, rng, ready_count, blocked_count, stats, running_state_trace, curr_time);
+				continue;
+			}
+
+			Process* curr_proc_running = running[c];
+			ReadyQueue* ready_pqueue = ready_pqueues[c];
+			PROFILE_START(PHASE_SCHEDULING);
+			// =========================================================================================================================================== //
+
+			// There is another process running, so we have to obtain the process with the highest priority
+			// from the ready_pqueue, and compare it with the one currently running. If it's higher, it'll take
+			// the curr_process's place(only if its not in the CS, else it'll be blocked) which will be inserted back into the ready_pqueue.
+			if ((ready_queue_size(ready_pqueue) != 0) && (curr_proc_running != NULL)) {
+				competitor_proc = ready_queue_max(ready_pqueue);
+				competitor_proc->cs_enter_probability = rand_uniform(0, 100, rng);
+
+				// The curr_proc_running has attempted to enter its CS, and it's either running or blocked
+				if (curr_proc_running->sem_alloc != NULL) {
+					// Running in CS, so the curr_proc_running is gonna continue to run in its CS
+					if (sem_holds(curr_proc_running->sem_alloc, curr_proc_running)) {
+						
+						// the competitor process attempts to enter its CS and is blocked, since the curr process is in its CS
+						if (competitor_proc->cs_enter_probability >= k) {
+							competitor_proc->blocked_time++;
+							blocked_time_slots[competitor_proc->priority - 1]++;
+							PROFILE_COUNT(COUNT_BLOCKS);
+						}
+					}
+					// It was blocked. The highest priority process is gonna run
+					else {
+						// We obtain the highest priority process, which will be stored as curr_proc_running
+						if (competitor_proc->priority < curr_proc_running->priority) {  // the competitor_proc has higher priority and must take its place!
+
+							// The competitor is gonna run, so the curr_proc_running is blocked
+							curr_proc_running->cs_enter_probability = rand_uniform(0, 100, rng);
+							if (curr_proc_running->cs_enter_probability >= k) {
+								curr_proc_running->blocked_time++;
+								blocked_time_slots[curr_proc_running->priority - 1]++;
+								PROFILE_COUNT(COUNT_BLOCKS);
+							}
+							ready_pq_remove_max(ready_pqueue, expiry_pqueue, ready_count, curr_time);			// removing competitor_process from the ready_pq, since it is gonna run
+							ready_pq_insert(ready_pqueues, c, expiry_pqueue, curr_proc_running, ready_count, curr_time);	// the previously curr_process_running is pushed back into the ready_queue
+						
+							curr_proc_running = competitor_proc;						// and the competitor is the new current process running
+							PROFILE_COUNT(COUNT_PREEMPTIONS);
+							if(curr_proc_running->start_time == NOT_STARTED)						// if it's the beginning of its execution
+								competitor_proc->start_time = curr_time;
+						}
+						// else the curr_proc_running has a higher priority than the competitor_proc, so it continues running
+					}
+				}
+
+				// The sem_alloc is NULL, so the curr_proc_running has never attempted to enter its CS, or previous CS was done.
+				// So we find the process with the higher priority to run
+				else {
+					// We obtain the highest priority process, which will be stored as curr_proc_running
+					if (competitor_proc->priority < curr_proc_running->priority) {  // the competitor_proc has higher priority and must take its place!
+						
+						// The competitor is gonna run, so the curr_proc_running is blocked
+						curr_proc_running->cs_enter_probability = rand_uniform(0, 100, rng);
+						if (curr_proc_running->cs_enter_probability >= k) {
+							curr_proc_running->blocked_time++;
+							blocked_time_slots[curr_proc_running->priority - 1]++;
+							PROFILE_COUNT(COUNT_BLOCKS);
+						}
+						ready_pq_remove_max(ready_pqueue, expiry_pqueue, ready_count, curr_time);			// removing competitor_process from the ready_pq, since it is gonna run
+						ready_pq_insert(ready_pqueues, c, expiry_pqueue, curr_proc_running, ready_count, curr_time);	// the previously curr_process_running is pushed back into the ready_queue
+					
+						curr_proc_running = competitor_proc;						// and the competitor is the new current process running
+						PROFILE_COUNT(COUNT_PREEMPTIONS);
+						if(curr_proc_running->start_time == NOT_STARTED)						// if it's the beginning of its execution
+							competitor_proc->start_time = curr_time;
+					}
+					// else the curr_proc_running has a higher priority than the competitor_proc, so it continues running
+				}
+			}
+			// =========================================================================================================================================== //
+			// There is no other process running on this cpu.
+			// The last process is going to run here
+			if ((ready_queue_size(ready_pqueue) != 0) && (curr_proc_running == NULL)) {
+				curr_proc_running = ready_pq_remove_max(ready_pqueue, expiry_pqueue, ready_count, curr_time);	// the highest priority process will be running
+				if(curr_proc_running->start_time == NOT_STARTED)
+					curr_proc_running->start_time = curr_time;			// it's the beginning of its execution
+			}
+			// =========================================================================================================================================== //
+			PROFILE_END(PHASE_SCHEDULING);
+			// Now, we have the current process running with the highest priority, if it's not NULL, and we're gonna see if it's gonna enter its CS
+			if (curr_proc_running != NULL) {
+				bool blocked = false;	// the semaphore is used by a process running on another cpu
+				PROFILE_START(PHASE_SEMAPHORES);
+
+				// current process running not done with its CS yet, or not having entered its CS yet
+				if (curr_proc_running->cs_time_executed < curr_proc_running->cs_time) {
+
+					// The process that was blocked before from entering its CS, enters now
+					if (curr_proc_running->sem_alloc != NULL) {
+						if (sem_try_down(curr_proc_running->sem_alloc, curr_proc_running)) { // the semaphore is avalaible, so the process enters its CS
+							curr_proc_running->cs_time_executed++;
+							cs_time_slots[curr_proc_running->priority - 1]++;
+						}
+						else
+							blocked = true;
+					}
+					// Hasn't attempted sem_down() yet, or previous CS was done, so it enters its CS with a probability
+					else {
+						// Checking to see if the process is gonna enter its CS, depending on the probability
+						curr_proc_running->cs_enter_probability = rand_uniform(0, 100, rng);
+						if (curr_proc_running->cs_enter_probability >= k) {
+							curr_proc_running->sem_alloc = sem_set[rand_uniform(1, S, rng) - 1];
+							if (sem_try_down(curr_proc_running->sem_alloc, curr_proc_running)) { // the semaphore is avalaible, so the process enters its CS
+								curr_proc_running->cs_time_executed++;
+								cs_time_slots[curr_proc_running->priority - 1]++;
+							}
+							else
+								blocked = true;	// it attempts the same semaphore again, in the next slot it runs
+						}
+						// else not entering its CS, but not inserting back into the pq, since it can continue to run outside the CS
+					}
+				}
+				// it's "cs_time_executed >= cs_time" so its CS is done..Setting sem_alloc equal to NULL, so that on a possible 
+				// next CS enter attempt, it can try to use a different or even the same Semaphore. We don't insert it back into the ready_pq,
+				// because it can continue running outside of the CS, till another process with higher priority comes
+				// Only if it took a semaphore, since a CS of no time is done before it's entered
+				else if (curr_proc_running->sem_alloc != NULL) {
+					sem_up(curr_proc_running->sem_alloc, curr_proc_running);	// nobody waits in its wait queue, without --sem-queues
+					curr_proc_running->cs_time_executed = 0;	// initializing for a possible entry to the CS again
+					curr_proc_running->sem_alloc = NULL;
+				}
+
+				PROFILE_END(PHASE_SEMAPHORES);
+
+				// Blocked, so it doesn't run in this slot, but it keeps the cpu till the semaphore is available or a higher priority process comes
+				if (blocked) {
+					curr_proc_running->blocked_time++;
+					blocked_time_slots[curr_proc_running->priority - 1]++;
+					PROFILE_COUNT(COUNT_BLOCKS);
+				}
+				else {
+					curr_proc_running->time_slots_running++;
+					running_time_slots[curr_proc_running->priority - 1]++; // increment time slot used by this set of processes with this priority
+					busy_slots[c]++;
+					
+					// printing the running state of the process to an external file
+					PROFILE_START(PHASE_TRACE);
+					trace_running(running_state_trace, curr_time, curr_proc_running->pid, curr_proc_running->time_slots_running, running_semid(curr_proc_running));
+					PROFILE_END(PHASE_TRACE);
+				}
+			}
+			running[c] = curr_proc_running;
+		}
+
+		PROFILE_START(PHASE_WAITING);
+		incr_proc_waiting_time(ready_count, waiting_time_slots, 1);	// increase waiting time of the functions in the ready_pqs, waiting to be executed
+		incr_proc_blocked_time(blocked_count, blocked_time_slots, 1);	// and blocked time of the ones in the wait queues of the semaphores
+		PROFILE_END(PHASE_WAITING);
+		curr_time++;	// next_time_slot
+	}
+	PROFILE_TOTAL_END();
+
+	stats->total_slots = curr_time;
+
+	// deallocating memory 
+	free_resources(arrivals, ready_pqueues, cpus, expiry_pqueue, processes_pool, sem_set, S);
+	free(running);
+}
+
+// Printing waiting, blocked, running, cs state for each set of priorities of the processes
+void print_stats(SimulationStats* stats, int cpus) {
+	for (int i = 0; i < 7; i++) {
+		printf("Waiting for: %d, Blocked for: %d, Running for: %d, Critical section for: %d time slots for processes with priority: %d\n", stats->waiting_time_slots[i], stats->blocked_time_slots[i], stats->running_time_slots[i], stats->cs_time_slots[i], i + 1);
+	}
+
+	// and the mean, min and max of the finished processes
+	for (int i = 0; i < 7; i++) {
+		Aggregate* turnaround = &stats->turnaround[i], *waiting = &stats->waiting[i], *blocked = &stats->blocked[i];
+		printf("Finished: %ld processes, Turnaround: %.2f (min %.2f, max %.2f), Waiting: %.2f (min %.0f, max %.0f), Blocked: %.2f (min %.0f, max %.0f) time slots for processes with priority: %d\n",
+			   turnaround->count, aggregate_mean(turnaround), turnaround->min, turnaround->max, aggregate_mean(waiting), waiting->min, waiting->max,
+			   aggregate_mean(blocked), blocked->min, blocked->max, i + 1);
+	}
+
+	// and their tail latencies
+	for (int i = 0; i < 7; i++) {
+		Aggregate* metrics[] = { &stats->response[i], &stats->turnaround[i], &stats->waiting[i], &stats->blocked[i] };
+		const char* names[] = { "Response", "Turnaround", "Waiting", "Blocked" };
+		printf("p50/p90/p99/p999:");
+		for (int m = 0; m < 4; m++)
+			printf(" %s: %.0f/%.0f/%.0f/%.0f%s", names[m], aggregate_percentile(metrics[m], 50), aggregate_percentile(metrics[m], 90),
+				   aggregate_percentile(metrics[m], 99), aggregate_percentile(metrics[m], 99.9), m < 3 ? "," : "");
+		printf(" time slots for processes with priority: %d\n", i + 1);
+	}
+
+	// and the utilization of each cpu, in the multi-cpu mode
+	if (cpus > 1) {
+		for (int c = 0; c < cpus; c++)
+			printf("Busy for: %d of %d time slots, Utilization: %.2f%% for cpu: %d\n", stats->busy_slots[c], stats->total_slots, stats->total_slots ? 100.0 * stats->busy_slots[c] / stats->total_slots : 0.0, c);
+	}
+}
+
+void print_histograms(SimulationStats* stats) {
+	for (int i = 0; i < 7; i++) {
+		printf("Response histogram for processes with priority %d:", i + 1);
+		aggregate_print_histogram(&stats->response[i], stdout);
+		printf("Turnaround histogram for processes with priority %d:", i + 1);
+		aggregate_print_histogram(&stats->turnaround[i], stdout);
+		printf("Waiting histogram for processes with priority %d:", i + 1);
+		aggregate_print_histogram(&stats->waiting[i], stdout);
+		printf("Blocked histogram for processes with priority %d:", i + 1);
+		aggregate_print_histogram(&stats->blocked[i], stdout);
+	}
+}
+
+bool dump_histograms(SimulationStats* stats, const char* filename) {
+	FILE* out = fopen(filename, "w");
+	if (out == NULL)
+		return false;
+
+	const char* names[] = { "response", "turnaround", "waiting", "blocked" };
+	size_t length = strlen(filename);
+	bool json = length >= 5 && strcmp(filename + length - 5, ".json") == 0;
+
+	// {"priorities": [{"priority": 1, "response": {..}, "turnaround": {..}, ..}, ..]}
+	if (json)
+		fprintf(out, "{\"priorities\": [\n");
+	else
+		fprintf(out, "priority,metric,low,high,count\n");
+	for (int i = 0; i < 7; i++) {
+		Aggregate* metrics[] = { &stats->response[i], &stats->turnaround[i], &stats->waiting[i], &stats->blocked[i] };
+		if (json)
+			fprintf(out, "  {\"priority\": %d", i + 1);
+		for (int m = 0; m < 4; m++) {
+			if (json) {
+				fprintf(out, ",\n   \"%s\": ", names[m]);
+				aggregate_write_json(metrics[m], out);
+			}
+			else {
+				char prefix[32];
+				snprintf(prefix, sizeof(prefix), "%d,%s", i + 1, names[m]);
+				aggregate_write_csv(metrics[m], prefix, out);
+			}
+		}
+		if (json)
+			fprintf(out, "}%s\n", i < 6 ? "," : "");
+	}
+	if (json)
+		fprintf(out, "]}\n");
+	return fclose(out) == 0;
+}
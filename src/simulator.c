@@ -1,385 +1,259 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include <unistd.h>
 #include <string.h>
-#include <limits.h>
 #include <time.h>
-#include "../include/semaphore.h"
+#include <getopt.h>
 #include "common_types.h"
-#include "ADTPriorityQueue.h"
-#include "ADTVector.h"
+#include "simulation.h"
+#include "replication.h"
+#include "sweep.h"
+#include "profile.h"
 
-//// ======================================================== P R O C E S S ======================================================== ////
-typedef struct process {
-	int pid;
-	int priority;
-	double arrival_time;
-	double lifetime;
-	int time_slots_running;
-	int start_time;
-	int end_time;
-	int waiting_time;
-	int blocked_time;
-
-	double cs_time;
-	int cs_enter_probability;
-	int cs_time_executed;
-	Semaphore sem_alloc;
-} Process;
-
-// compare based first on arrival time, then on priority, and then on pid
-int process_pool_compare(void *a, void *b)
-{
-    int to_return = (((Process*)b)->arrival_time - ((Process*)a)->arrival_time);
-	if (to_return == 0)
-		return (((Process*)b)->priority - ((Process*)a)->priority);
-	if (to_return == 0)
-		return (((Process*)b)->pid - ((Process*)a)->pid);
-    return to_return;
-}
-
-// compare based first on priority, then on arrival time, and then on pid
-int ready_pq_compare(void *a, void *b)
-{
-    int to_return = (((Process*)b)->priority - ((Process*)a)->priority);
-	if (to_return == 0)
-		return (((Process*)b)->arrival_time - ((Process*)a)->arrival_time);
-	if (to_return == 0)
-		return (((Process*)b)->pid - ((Process*)a)->pid);
-    return to_return;
-}
-
-// compare based first on end_time, then on arrival time, and then on pid
-int finished_pq_compare(void *a, void *b) {
-	int to_return = (((Process*)b)->end_time - ((Process*)a)->end_time);
-	if (to_return == 0)
-		return (((Process*)b)->arrival_time - ((Process*)a)->arrival_time);
-	if (to_return == 0)
-		return (((Process*)b)->pid - ((Process*)a)->pid);
-    return to_return;
-}
-
-double rand_exponential(double lambda) { return -log(1.0 - rand() / (RAND_MAX + 1.0))/lambda; }
-
-int rand_uniform(int low, int high) {
-	int range = high - low +1;
-	double rand_var = rand() / (RAND_MAX + 1.0);
-	return (rand_var*range) + low;
-}
-
-// creates and initializes total_processes Processes and returns a PQ of them
-PriorityQueue* processes_generator(int total_processes, double lambda_arrival, double lambda_lifetime, double lambda_cs_time) {
-	
-	// create process pool, ordered by arrival_time(process_pool_compare function)
-	PriorityQueue* processes_pq = pqueue_create(process_pool_compare, NULL, NULL);
-	double time = 0;
-	
-	for (int i = 0; i < total_processes; i++) {
-		Process* proc = malloc(sizeof(*proc));
-		
-		proc->pid = i;
-		proc->priority = rand_uniform(1, 7);
-		
-		// the arrival time of the current process = arrival_time of the previously created process("time" in our code)
-		// + the exponential time between 2 arrivals
-		proc->arrival_time = time + rand_exponential(lambda_arrival);
-		time = proc->arrival_time;
-
-		proc->lifetime = rand_exponential(lambda_lifetime);
-		proc->lifetime += proc->arrival_time;	// lifetime counts from the moment the process arrives
-
-		proc->time_slots_running = 0;
-		proc->start_time = 0;
-		proc->end_time = 0;
-		proc->waiting_time = 0;
-		proc->blocked_time = 0;
-
-		proc->cs_time = rand_exponential(lambda_cs_time);
-		proc->cs_time_executed = 0;
-		proc->sem_alloc = NULL;
-
-		// initialization is complete so insert it into the pqueue
-		pqueue_insert(processes_pq, proc);
-	}
-	return processes_pq;
-}
-
-// Function for processes ~~ waiting ~~ in a pqueue to be executed
-void incr_proc_waiting_time(PriorityQueue* pq, int* waiting_time_slots) {
-	Vector* vec = pqueue_get_vector(pq);
-
-	// incrementing the processes' waiting_time
-	for (int i = 0; i < vector_size(vec); i++) {
-		// ((Process*)pqueue_node_value(node_value(pq, i+1)))->waiting_time++;
-		Process* p_to_incr = pqueue_node_value(node_value(pq, i+1));
-		p_to_incr->waiting_time++;
-		waiting_time_slots[p_to_incr->priority - 1]++;
-	}
-}
-
-// checking if any process is not alive any more, except for the one that is already running (that's a seperate check)
-void checkIfAnyProcessPassedItsLifetime(PriorityQueue* ready_pq, PriorityQueue* finished_pq, int current_time, Process* curr_proc_running) {
-	Vector* vec = pqueue_get_vector(ready_pq);
-
-	for (int i = 0; i < vector_size(vec); i++) {
-		Process* prob_fin_proc = pqueue_node_value(node_value(ready_pq, i+1));		// probably_finished_process
-
-		if (prob_fin_proc->lifetime <= current_time) {
-			pqueue_remove_node(ready_pq, (PriorityQueueNode*)node_value(ready_pq, i + 1));
-			prob_fin_proc->end_time = current_time;
-			
-			// if that process is in its CS, force up()
-			if (prob_fin_proc->sem_alloc != NULL) {
-				// running its CS rn
-				if (sem_used_by_process(prob_fin_proc->sem_alloc) == prob_fin_proc->pid)
-					sem_up(prob_fin_proc->sem_alloc);
-				
-				prob_fin_proc->sem_alloc = NULL;
-			}
-			pqueue_insert(finished_pq, prob_fin_proc);	// it's finished
+int main(int argc, char* argv[]) {
 
-			// the prob_fin_proc is the curr_proc_running
-			if ((curr_proc_running != NULL) && (prob_fin_proc->pid == curr_proc_running->pid))	// if the lifetime of the process currently running just ended, we change the value 
-				curr_proc_running = NULL;	// of the currently running to NULL, so in the next time_slot, we don't compare priorities again with other processes
+	uint64_t seed = time(NULL);	// the same seed gives the same simulation
+	SimulationParams params = { .cpus = 1, .event_driven = false, .ready_queue_type = READY_PQUEUE, .workload = NULL, .sem_count = 1, .sem_queues = false, .sem_protocol = SEM_PROTOCOL_NONE };
+	const char* workload_filename = NULL;	// replay the processes of this file, instead of generating them
+	SimulationStats stats;
+	Trace* running_state_trace = NULL;	// NULL if tracing is disabled
+
+	int replications = 0;	// number of independent simulations, 0 for a single one
+	int threads = sysconf(_SC_NPROCESSORS_ONLN);	// threads running the replications, one per core by default
+	bool trace_enabled = true;	// write the running state of every slot to running_state.log
+	TraceFormat trace_format = TRACE_TEXT;
+	int trace_buffer_size = TRACE_DEFAULT_BUFFER_SIZE;
+	int trace_flush_every = 0;	// flush the trace only when its buffer is full
+	const char* completion_log_filename = NULL;	// append every finished process to this file
+	FILE* completion_log = NULL;
+	bool histograms = false;	// print the histograms of the finished processes
+	const char* histograms_filename = NULL;	// and/or write them to this file, as JSON or CSV
+	bool profile = false;	// print the time of every phase of the main loop and the event counters(-DPROFILE)
+	bool protocols = false;	// compare the blocked time with every --sem-protocol, instead of a single simulation
+	bool sweep = false;		// the parameters are comma separated lists, and every combination of them is simulated
+	SweepGrid grid;
+
+	// options with no short version
+	enum { OPT_NO_TRACE = 256, OPT_TRACE_BUFFER, OPT_TRACE_FLUSH, OPT_TRACE_FORMAT, OPT_READY_QUEUE, OPT_SEED, OPT_WORKLOAD, OPT_COMPLETION_LOG, OPT_HISTOGRAMS, OPT_DUMP_HISTOGRAMS, OPT_PROFILE, OPT_SEM_QUEUES, OPT_SEM_COUNT, OPT_SEM_PROTOCOL, OPT_COMPARE_PROTOCOLS, OPT_SWEEP };
+	static struct option long_options[] = {
+		{"event-driven", no_argument, NULL, 'e'},
+		{"cpus", required_argument, NULL, 'c'},
+		{"replications", required_argument, NULL, 'r'},
+		{"threads", required_argument, NULL, 'j'},
+		{"no-trace", no_argument, NULL, OPT_NO_TRACE},
+		{"trace-buffer", required_argument, NULL, OPT_TRACE_BUFFER},
+		{"trace-flush", required_argument, NULL, OPT_TRACE_FLUSH},
+		{"trace-format", required_argument, NULL, OPT_TRACE_FORMAT},
+		{"ready-queue", required_argument, NULL, OPT_READY_QUEUE},
+		{"seed", required_argument, NULL, OPT_SEED},
+		{"workload", required_argument, NULL, OPT_WORKLOAD},
+		{"completion-log", required_argument, NULL, OPT_COMPLETION_LOG},
+		{"histograms", no_argument, NULL, OPT_HISTOGRAMS},
+		{"dump-histograms", required_argument, NULL, OPT_DUMP_HISTOGRAMS},
+		{"profile", no_argument, NULL, OPT_PROFILE},
+		{"sem-queues", no_argument, NULL, OPT_SEM_QUEUES},
+		{"sem-count", required_argument, NULL, OPT_SEM_COUNT},
+		{"sem-protocol", required_argument, NULL, OPT_SEM_PROTOCOL},
+		{"compare-protocols", no_argument, NULL, OPT_COMPARE_PROTOCOLS},
+		{"sweep", no_argument, NULL, OPT_SWEEP},
+		{NULL, 0, NULL, 0}
+	};
+	int opt;
+	while ((opt = getopt_long(argc, argv, "ec:r:j:", long_options, NULL)) != -1) {
+		switch (opt) {
+			case 'e':
+				params.event_driven = true;
+				break;
+			case 'c':
+				params.cpus = atoi(optarg);
+				if (params.cpus < 1)
+					argc = 0;	// wrong number of cpus, print the usage below
+				break;
+			case 'r':
+				replications = atoi(optarg);
+				if (replications < 1)
+					argc = 0;	// wrong number of replications, print the usage below
+				break;
+			case 'j':
+				threads = atoi(optarg);
+				if (threads < 1)
+					argc = 0;	// wrong number of threads, print the usage below
+				break;
+			case OPT_NO_TRACE:
+				trace_enabled = false;
+				break;
+			case OPT_TRACE_BUFFER:
+				trace_buffer_size = atoi(optarg);
+				break;
+			case OPT_TRACE_FLUSH:
+				trace_flush_every = atoi(optarg);
+				break;
+			case OPT_TRACE_FORMAT:
+				if (strcmp(optarg, "text") == 0)
+					trace_format = TRACE_TEXT;
+				else if (strcmp(optarg, "binary") == 0)
+					trace_format = TRACE_BINARY;
+				else
+					argc = 0;	// wrong format, print the usage below
+				break;
+			case OPT_READY_QUEUE:
+				if (strcmp(optarg, "pqueue") == 0)
+					params.ready_queue_type = READY_PQUEUE;
+				else if (strcmp(optarg, "heap") == 0)
+					params.ready_queue_type = READY_HEAP;
+				else if (strcmp(optarg, "multilevel") == 0)
+					params.ready_queue_type = READY_MULTILEVEL;
+				else
+					argc = 0;	// wrong implementation, print the usage below
+				break;
+			case OPT_SEED:
+				seed = strtoull(optarg, NULL, 10);
+				break;
+			case OPT_WORKLOAD:
+				workload_filename = optarg;
+				break;
+			case OPT_COMPLETION_LOG:
+				completion_log_filename = optarg;
+				break;
+			case OPT_HISTOGRAMS:
+				histograms = true;
+				break;
+			case OPT_DUMP_HISTOGRAMS:
+				histograms_filename = optarg;
+				break;
+			case OPT_PROFILE:
+				profile = true;
+				break;
+			case OPT_SEM_QUEUES:
+				params.sem_queues = true;
+				break;
+			case OPT_SEM_COUNT:
+				params.sem_count = atoi(optarg);
+				if (params.sem_count < 1)
+					argc = 0;	// wrong number of units, print the usage below
+				break;
+			case OPT_SEM_PROTOCOL:
+				params.sem_queues = true;	// the protocols work on the wait queues of the semaphores
+				if (strcmp(optarg, "none") == 0)
+					params.sem_protocol = SEM_PROTOCOL_NONE;
+				else if (strcmp(optarg, "inheritance") == 0)
+					params.sem_protocol = SEM_PROTOCOL_INHERITANCE;
+				else if (strcmp(optarg, "ceiling") == 0)
+					params.sem_protocol = SEM_PROTOCOL_CEILING;
+				else
+					argc = 0;	// wrong protocol, print the usage below
+				break;
+			case OPT_COMPARE_PROTOCOLS:
+				protocols = true;
+				break;
+			case OPT_SWEEP:
+				sweep = true;
+				break;
+			default:
+				argc = 0;	// wrong option, print the usage below
+				break;
 		}
-		vec = pqueue_get_vector(ready_pq);
 	}
-}
-
-// deallocating memory 
-void free_resources(PriorityQueue* finished_pqueue, PriorityQueue* ready_pqueue, PriorityQueue* processes_pool, Semaphore* sem_set, int S) {
-	pqueue_destroy(finished_pqueue); // all the processes, that we want to deallocate memory for are in the finished pqueue, in the end
-	pqueue_destroy(ready_pqueue);
-	pqueue_destroy(processes_pool);
-	destroy_semaphores(sem_set, S);
-}
-//// ========================================================  S I M U L A T O R  ======================================================== ////
-
-int main(int argc, char* argv[]) {
-
-	srand(time(NULL));
 
-	double lambda_arrival, lambda_lifetime, lambda_cs_time;
-	int total_processes, k, S;
-	int running_time_slots[7]; // time slots for each of the 7 sets of priority processes..priority-1based : running_time_slots[0]..priority-2based : running_time_slots[1], etc
-	int waiting_time_slots[7];
-	int blocked_time_slots[7];
-	int cs_time_slots[7];
-	int curr_time = 0;
-	FILE* running_state_fp;
-	Process* curr_proc_running = NULL;
-	Semaphore* sem_set;
-	PriorityQueue* processes_pool, *ready_pqueue, *finished_pqueue;
-
-	// Correct number of arguments needed
-	if (argc != 7) {
-		fprintf(stderr, "Error! Correct Usage: ./simulator <lambda_arrival> <lambda_lifetime> <lambda_cs_time> <total_processes> <k: down() probability> <S: Num of Semaphores>\n");
+	// Correct number of arguments needed, the processes of a workload file aren't generated, so it needs only k and S
+	// With --sweep every one of them is a list of values
+	if (argc - optind == (workload_filename != NULL ? 2 : 6) && sweep) {
+		for (int i = 0; i < argc - optind; i++)
+			if (!sweep_parse(&grid, (workload_filename != NULL ? SWEEP_K : SWEEP_LAMBDA_ARRIVAL) + i, argv[optind + i]))
+				argc = 0;	// wrong list, print the usage below
+	}
+	if (argc - optind != (workload_filename != NULL ? 2 : 6)) {
+		fprintf(stderr, "Error! Correct Usage: ./simulator [-e|--event-driven] [-c|--cpus <cpus>] [-r|--replications <R> [-j|--threads <threads>]] [--no-trace] [--trace-buffer <bytes>] [--trace-flush <records>] [--trace-format text|binary] [--ready-queue pqueue|heap|multilevel] [--seed <seed>] [--completion-log <file>] [--histograms] [--dump-histograms <file.json|file.csv>] [--profile] [--sem-queues] [--sem-count <units>] [--sem-protocol none|inheritance|ceiling] [--compare-protocols] [--sweep] <lambda_arrival> <lambda_lifetime> <lambda_cs_time> <total_processes> <k: down() probability> <S: Num of Semaphores>\n"
+						"       ./simulator [options] --workload <workload file> <k: down() probability> <S: Num of Semaphores>\n"
+						"       with --sweep every parameter is a comma separated list of values, like 0.1,0.5,1\n"
+						"       -e skips the idle slots, and with a single cpu the slots in which the running process continues its CS or runs\n"
+						"       without attempting to enter it, till the next arrival or lifetime expiry. With -c every other slot is still stepped\n");
 		exit(EXIT_FAILURE);
 	}
-	
-	lambda_arrival = atof(argv[1]);
-	lambda_lifetime = atof(argv[2]);
-	lambda_cs_time = atof(argv[3]);
-	total_processes = atoi(argv[4]);
-	k = atoi(argv[5]);
-	S = atoi(argv[6]);
 
-	// Initializing the file of the 'running state' and deleting its contents if it already exists
-	fclose(fopen("running_state.log", "w"));
-
-	// initialization
-	for (int i = 0; i < 7; i++) {
-		running_time_slots[i] = 0;
-		waiting_time_slots[i] = 0;
-		blocked_time_slots[i] = 0;
-		cs_time_slots[i] = 0;
+	if (workload_filename != NULL) {
+		params.workload = workload_open(workload_filename);
+		if (params.workload == NULL)
+			error_exit("workload: open failed");
 	}
 
-	sem_set = create_semaphores(S);
-	processes_pool = processes_generator(total_processes, lambda_arrival, lambda_lifetime, lambda_cs_time);	// all created processes
-	ready_pqueue = pqueue_create(ready_pq_compare, NULL, NULL);	// all processes that have arrived
-	finished_pqueue = pqueue_create(finished_pq_compare, free, NULL);	// all processes that are finished, each node holds a Process* for which we allocated memory before, so free it upon destroy.
-
-	// while there are still processes created and not all done yet
-	// a time slot is this while loop
-	while (pqueue_size(finished_pqueue) != total_processes) {
-		Process* proc_insert, *competitor_proc;
-
-		// obtains the first arrived processes and inserts them into the ready_pqueue
-		while((pqueue_size(processes_pool) != 0) && (proc_insert = pqueue_max(processes_pool)) && (proc_insert->arrival_time <= curr_time)) {
-			Process* ready_process = pqueue_remove_max(processes_pool);
-			pqueue_insert(ready_pqueue, ready_process);
-		}
-
-		// the current process is not alive any more
-		if ((curr_proc_running != NULL) && (curr_proc_running->lifetime <= curr_time)) {
-				curr_proc_running->end_time = curr_time;
-
-			// if the process is at its CS, force up()
-			if (curr_proc_running->sem_alloc != NULL) {
-				// running its CS rn
-				if (sem_used_by_process(curr_proc_running->sem_alloc) == curr_proc_running->pid)
-					sem_up(curr_proc_running->sem_alloc);
-					
-				curr_proc_running->sem_alloc = NULL;
-			}
-
-			// printing the running state of the process to an external file
-			running_state_fp = fopen("running_state.log", "a");
-			if (running_state_fp == NULL) {
-				// deallocating memory 
-				free_resources(finished_pqueue, ready_pqueue, processes_pool, sem_set, S);
-				error_exit("running_state_fp: fopen failed");
-			}
-			fprintf(running_state_fp, "Finishing now Process with PID: %d\n", curr_proc_running->pid);
-			fclose(running_state_fp);
-			
-			pqueue_insert(finished_pqueue, curr_proc_running);
-			curr_proc_running = NULL;
-		}
-
-		// before extracting the max_process from ready_pq:
-		// checks for non alive processes in the ready_pqueue, where they are all supposed to be alive
-		// and if there exist, it takes them from the ready_pq to the finished_pq, every time slot passing by
-		checkIfAnyProcessPassedItsLifetime(ready_pqueue, finished_pqueue, curr_time, curr_proc_running);
-
-		// =========================================================================================================================================== //
-
-		// There is another process running, so we have to obtain the process with the highest priority
-		// from the ready_pqueue, and compare it with the one currently running. If it's higher, it'll take
-		// the curr_process's place(only if its not in the CS, else it'll be blocked) which will be inserted back into the ready_pqueue.
-		if ((pqueue_size(ready_pqueue) != 0) && (curr_proc_running != NULL)) {
-			competitor_proc = pqueue_max(ready_pqueue);
-			competitor_proc->cs_enter_probability = rand() % 101;
-
-			// The curr_proc_running has attempted to enter its CS, and it's either running or blocked
-			if (curr_proc_running->sem_alloc != NULL) {
-				// Running in CS, so the curr_proc_running is gonna continue to run in its CS
-				if (sem_used_by_process(curr_proc_running->sem_alloc) == curr_proc_running->pid) {
-					
-					// the competitor process attempts to enter its CS and is blocked, since the curr process is in its CS
-					if (competitor_proc->cs_enter_probability >= k) {
-						competitor_proc->blocked_time++;
-						blocked_time_slots[competitor_proc->priority - 1]++;
-					}
-				}
-				// It was blocked. The highest priority process is gonna run
-				else {
-					// We obtain the highest priority process, which will be stored as curr_proc_running
-					if (competitor_proc->priority < curr_proc_running->priority) {  // the competitor_proc has higher priority and must take its place!
-
-						// The competitor is gonna run, so the curr_proc_running is blocked
-						curr_proc_running->cs_enter_probability = rand() % 101;
-						if (curr_proc_running->cs_enter_probability >= k) {
-							curr_proc_running->blocked_time++;
-							blocked_time_slots[curr_proc_running->priority - 1]++;
-						}
-						pqueue_remove_max(ready_pqueue);							// removing competitor_process from the ready_pq, since it is gonna run
-						pqueue_insert(ready_pqueue, curr_proc_running);  			// the previously curr_process_running is pushed back into the ready_queue
-					
-						curr_proc_running = competitor_proc;						// and the competitor is the new current process running
-						if(curr_proc_running->start_time == 0)						// if it's the beginning of its execution
-							competitor_proc->start_time = curr_time;
-					}
-					// else the curr_proc_running has a higher priority than the competitor_proc, so it continues running
-				}
-			}
-
-			// The sem_alloc is NULL, so the curr_proc_running has never attempted to enter its CS, or previous CS was done.
-			// So we find the process with the higher priority to run
-			else {
-				// We obtain the highest priority process, which will be stored as curr_proc_running
-				if (competitor_proc->priority < curr_proc_running->priority) {  // the competitor_proc has higher priority and must take its place!
-					
-					// The competitor is gonna run, so the curr_proc_running is blocked
-					curr_proc_running->cs_enter_probability = rand() % 101;
-					if (curr_proc_running->cs_enter_probability >= k) {
-						curr_proc_running->blocked_time++;
-						blocked_time_slots[curr_proc_running->priority - 1]++;
-					}
-					pqueue_remove_max(ready_pqueue);							// removing competitor_process from the ready_pq, since it is gonna run
-					pqueue_insert(ready_pqueue, curr_proc_running);  			// the previously curr_process_running is pushed back into the ready_queue
-				
-					curr_proc_running = competitor_proc;						// and the competitor is the new current process running
-					if(curr_proc_running->start_time == 0)						// if it's the beginning of its execution
-						competitor_proc->start_time = curr_time;
-				}
-				// else the curr_proc_running has a higher priority than the competitor_proc, so it continues running
-			}
-		}
-		// =========================================================================================================================================== //
-		// There is no other process running, so none of the semaphores is being used.
-		// The last process is going to run here
-		if ((pqueue_size(ready_pqueue) != 0) && (curr_proc_running == NULL)) {
-			curr_proc_running = pqueue_remove_max(ready_pqueue);	// the highest priority process will be running
-			if(curr_proc_running->start_time == 0)
-				curr_proc_running->start_time = curr_time;			// it's the beginning of its execution
-		}
-		// =========================================================================================================================================== //
-		// Now, we have the current process running with the highest priority, if it's not NULL, and we're gonna see if it's gonna enter its CS
-		if (curr_proc_running != NULL) {
-
-			// current process running not done with its CS yet, or not having entered its CS yet
-			if (curr_proc_running->cs_time_executed < curr_proc_running->cs_time) {
+	// R simulations(or a single one) of every combination of the lists, as CSV
+	if (sweep) {
+		run_sweep(&params, &grid, replications > 0 ? replications : 1, threads, seed, stdout);
+		if (params.workload != NULL)
+			workload_close(params.workload);
+		return 0;
+	}
 
-				// The process that was blocked before from entering its CS, enters now
-				if (curr_proc_running->sem_alloc != NULL) {
-					sem_down(curr_proc_running->sem_alloc, curr_proc_running->pid); // the semaphore is avalaible, so the process enters its CS
-					curr_proc_running->cs_time_executed++;
-					cs_time_slots[curr_proc_running->priority - 1]++;
-				}
-				// Hasn't attempted sem_down() yet, or previous CS was done, so it enters its CS with a probability
-				else {
-					// Checking to see if the process is gonna enter its CS, depending on the probability
-					curr_proc_running->cs_enter_probability = rand() % 101;
-					if (curr_proc_running->cs_enter_probability >= k) {
-						curr_proc_running->sem_alloc = sem_set[rand_uniform(1, S) - 1];
-						sem_down(curr_proc_running->sem_alloc, curr_proc_running->pid); // the semaphore is avalaible, so the process enters its CS
-						
-						curr_proc_running->cs_time_executed++;
-						cs_time_slots[curr_proc_running->priority - 1]++;
-					}
-					// else not entering its CS, but not inserting back into the pq, since it can continue to run outside the CS
-				}
-			}
-			// it's "cs_time_executed >= cs_time" so its CS is done..Setting sem_alloc equal to NULL, so that on a possible 
-			// next CS enter attempt, it can try to use a different or even the same Semaphore. We don't insert it back into the ready_pq,
-			// because it can continue running outside of the CS, till another process with higher priority comes
-			else {
-				if (sem_used_by_process(curr_proc_running->sem_alloc) == curr_proc_running->pid) {
-					sem_up(curr_proc_running->sem_alloc);
-				}
-				curr_proc_running->cs_time_executed = 0;	// initializing for a possible entry to the CS again
-				curr_proc_running->sem_alloc = NULL;
-			}
+	if (workload_filename == NULL) {
+		params.lambda_arrival = atof(argv[optind]);
+		params.lambda_lifetime = atof(argv[optind + 1]);
+		params.lambda_cs_time = atof(argv[optind + 2]);
+		params.total_processes = atoi(argv[optind + 3]);
+		optind += 4;
+	}
+	params.k = atoi(argv[optind]);
+	params.S = atoi(argv[optind + 1]);
+
+	// R simulations(or a single one) with every protocol, with no running state trace either
+	if (protocols) {
+		compare_protocols(&params, replications > 0 ? replications : 1, threads, seed);
+		if (params.workload != NULL)
+			workload_close(params.workload);
+		return 0;
+	}
 
-			curr_proc_running->time_slots_running++;
-			running_time_slots[curr_proc_running->priority - 1]++; // increment time slot used by this set of processes with this priority
-			
-			// printing the running state of the process to an external file
-			running_state_fp = fopen("running_state.log", "a");
-			if (running_state_fp == NULL) {
-				// deallocating memory 
-				free_resources(finished_pqueue, ready_pqueue, processes_pool, sem_set, S);
-				error_exit("running_state_fp: fopen failed");
-			}
-			fprintf(running_state_fp, "Running now Process with PID: %d, Current Service Time: %d\n", curr_proc_running->pid, curr_proc_running->time_slots_running);
-			fclose(running_state_fp);		
-		}
+	// R independent simulations on a pool of threads, with no running state trace, since they run at the same time
+	// The profile of every thread is its own, so it's printed only for a single simulation
+	if (replications > 0) {
+		if (profile)
+			fprintf(stderr, "--profile is ignored with replications\n");
+		SimulationStats* replication_stats = malloc(replications * sizeof(*replication_stats));
+		run_replications(&params, replications, threads, seed, replication_stats);
+		print_replication_stats(replication_stats, replications, params.cpus);
+		destroy_replication_stats(replication_stats, replications);
+		if (params.workload != NULL)
+			workload_close(params.workload);
+		return 0;
+	}
 
-		if(pqueue_size(ready_pqueue) != 0)
-			incr_proc_waiting_time(ready_pqueue, waiting_time_slots);	// increase waiting time of the functions in the ready_pq, waiting to be executed
-		curr_time++;	// next_time_slot
+	// Initializing the file of the 'running state' and deleting its contents if it already exists
+	// It stays open for the whole simulation, and the running states are written to it in batches
+	// The binary trace is written to running_state.bin instead, and can be decoded with trace_decode
+	if (trace_enabled) {
+		const char* trace_filename = trace_format == TRACE_BINARY ? "running_state.bin" : "running_state.log";
+		running_state_trace = trace_open(trace_filename, trace_format, trace_buffer_size, trace_flush_every);
+		if (running_state_trace == NULL)
+			error_exit("running_state trace: fopen failed");
 	}
 
-	// Printing waiting, blocked, running, cs state for each set of priorities of the processes
-	for (int i = 0; i < 7; i++) {
-		printf("Waiting for: %d, Blocked for: %d, Running for: %d, Critical section for: %d time slots for processes with priority: %d\n", waiting_time_slots[i], blocked_time_slots[i], running_time_slots[i], cs_time_slots[i], i + 1);
+	// The finished processes are appended to the completion log, one line each, through a big stdio buffer
+	if (completion_log_filename != NULL) {
+		completion_log = fopen(completion_log_filename, "w");
+		if (completion_log == NULL)
+			error_exit("completion log: fopen failed");
+		setvbuf(completion_log, NULL, _IOFBF, TRACE_DEFAULT_BUFFER_SIZE);
+		fprintf(completion_log, "%s\n", COMPLETION_LOG_HEADER);
 	}
 
-	// deallocating memory 
-	free_resources(finished_pqueue, ready_pqueue, processes_pool, sem_set, S);
+	stats.busy_slots = malloc(params.cpus * sizeof(*stats.busy_slots));
+	Rng rng;
+	rng_seed(&rng, seed);
+	simulate(&params, &rng, running_state_trace, completion_log, &stats);
+	print_stats(&stats, params.cpus);
+	if (histograms)
+		print_histograms(&stats);
+	if (histograms_filename != NULL && !dump_histograms(&stats, histograms_filename))
+		error_exit("histograms: writing failed");
+	if (profile)
+		profile_print(&profile_data, stdout);
+
+	free(stats.busy_slots);
+	trace_close(running_state_trace);	// the rest of the buffered running states are written to the file
+	if (completion_log != NULL && fclose(completion_log) != 0)
+		error_exit("completion log: fclose failed");
+	if (params.workload != NULL)
+		workload_close(params.workload);
 
 	return 0;
-}
\ No newline at end of file
+}
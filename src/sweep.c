@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////
+// Sweep implementation, generating the processes of every
+// workload once and running all the simulations that replay
+// them on the pool of threads of the replications
+///////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <math.h>
+#include "sweep.h"
+#include "replication.h"
+#include "arrival_source.h"
+
+#define SWEEP_STATS 7	// stats written for every combination and priority, with their confidence intervals
+
+bool sweep_parse(SweepGrid* grid, SweepParam param, const char* list) {
+	int count = 0;
+	const char* item = list;
+	while (true) {
+		char* end;
+		if (count == SWEEP_MAX_VALUES)
+			return false;
+		grid->values[param][count++] = strtod(item, &end);
+		if (end == item)
+			return false;
+		if (*end == '\0')
+			break;
+		if (*end != ',')
+			return false;
+		item = end + 1;
+	}
+	grid->count[param] = count;
+	return true;
+}
+
+// Writes the mean and the confidence interval of the stats of the replications of a combination, for every priority
+static void write_combination(SimulationParams* params, bool generated, SimulationStats* stats, int replications, double* values, FILE* out) {
+	for (int p = 0; p < PRIORITIES; p++) {
+		if (generated)
+			fprintf(out, "%g,%g,%g,%d,", params->lambda_arrival, params->lambda_lifetime, params->lambda_cs_time, params->total_processes);
+		fprintf(out, "%d,%d,%d", params->k, params->S, p + 1);
+
+		for (int m = 0; m < SWEEP_STATS; m++) {
+			for (int r = 0; r < replications; r++) {
+				SimulationStats* s = &stats[r];
+				switch (m) {
+					case 0:	values[r] = s->waiting_time_slots[p]; break;
+					case 1:	values[r] = s->blocked_time_slots[p]; break;
+					case 2:	values[r] = s->running_time_slots[p]; break;
+					case 3:	values[r] = s->cs_time_slots[p]; break;
+					case 4:	values[r] = s->turnaround[p].count; break;
+					case 5:	values[r] = aggregate_mean(&s->turnaround[p]); break;
+					case 6:	values[r] = aggregate_percentile(&s->turnaround[p], 99); break;
+				}
+			}
+			double mean, half_width;
+			mean_ci(values, replications, &mean, &half_width);
+			// the interval is left empty with a single replication
+			if (isnan(half_width))
+				fprintf(out, ",%.2f,", mean);
+			else
+				fprintf(out, ",%.2f,%.2f", mean, half_width);
+		}
+		fprintf(out, "\n");
+	}
+}
+
+void run_sweep(SimulationParams* params, SweepGrid* grid, int replications, int threads, uint64_t seed, FILE* out) {
+	bool generated = params->workload == NULL;
+	int* count = grid->count;
+	int workloads = 1;	// combinations of the parameters of the processes
+	if (generated)
+		workloads = count[SWEEP_LAMBDA_ARRIVAL] * count[SWEEP_LAMBDA_LIFETIME] * count[SWEEP_LAMBDA_CS_TIME] * count[SWEEP_TOTAL_PROCESSES];
+	int settings = count[SWEEP_K] * count[SWEEP_S];	// combinations that replay the same processes
+	int simulations = settings * replications;
+
+	Rng* replication_stream = malloc(replications * sizeof(*replication_stream));
+	Workload** replication_workload = malloc(replications * sizeof(*replication_workload));
+	SimulationParams* simulation_params = malloc(simulations * sizeof(*simulation_params));
+	SimulationParams** simulation_params_of = malloc(simulations * sizeof(*simulation_params_of));
+	Rng* streams = malloc(simulations * sizeof(*streams));
+	SimulationStats* stats = malloc(simulations * sizeof(*stats));
+	double* values = malloc(replications * sizeof(*values));
+	replication_streams(seed, replications, replication_stream);
+
+	if (generated)
+		fprintf(out, "lambda_arrival,lambda_lifetime,lambda_cs_time,total_processes,");
+	fprintf(out, "k,S,priority,waiting,waiting_ci,blocked,blocked_ci,running,running_ci,cs,cs_ci,finished,finished_ci,turnaround,turnaround_ci,turnaround_p99,turnaround_p99_ci\n");
+
+	// The workloads one after the other, so that only the processes of one of them are in memory at the same time,
+	// and all the simulations that replay them at the same time
+	for (int w = 0; w < workloads; w++) {
+		SimulationParams workload_params = *params;
+		if (generated) {
+			// the first parameter of the command line changes the slowest
+			int rest = w;
+			double value[SWEEP_TOTAL_PROCESSES + 1];
+			for (int p = SWEEP_TOTAL_PROCESSES; p >= SWEEP_LAMBDA_ARRIVAL; p--) {
+				value[p] = grid->values[p][rest % count[p]];
+				rest /= count[p];
+			}
+			workload_params.lambda_arrival = value[SWEEP_LAMBDA_ARRIVAL];
+			workload_params.lambda_lifetime = value[SWEEP_LAMBDA_LIFETIME];
+			workload_params.lambda_cs_time = value[SWEEP_LAMBDA_CS_TIME];
+			workload_params.total_processes = value[SWEEP_TOTAL_PROCESSES];
+		}
+
+		// the processes of replication r, from the same stream as a simulation of replication r would generate them
+		for (int r = 0; r < replications; r++) {
+			if (generated)
+				replication_workload[r] = arrival_source_generate_workload(workload_params.total_processes, workload_params.lambda_arrival,
+																		   workload_params.lambda_lifetime, workload_params.lambda_cs_time, &replication_stream[r]);
+			else
+				replication_workload[r] = params->workload;
+		}
+
+		// simulation i is replication i % replications of the setting i / replications
+		for (int i = 0; i < simulations; i++) {
+			int setting = i / replications, r = i % replications;
+			simulation_params[i] = workload_params;
+			simulation_params[i].k = grid->values[SWEEP_K][setting / count[SWEEP_S]];
+			simulation_params[i].S = grid->values[SWEEP_S][setting % count[SWEEP_S]];
+			simulation_params[i].workload = replication_workload[r];
+			simulation_params_of[i] = &simulation_params[i];
+			streams[i] = replication_stream[r];
+		}
+		run_simulations(simulation_params_of, streams, simulations, threads, stats);
+
+		for (int setting = 0; setting < settings; setting++)
+			write_combination(&simulation_params[setting * replications], generated, &stats[setting * replications], replications, values, out);
+
+		for (int i = 0; i < simulations; i++)
+			free(stats[i].busy_slots);
+		if (generated)
+			for (int r = 0; r < replications; r++)
+				workload_close(replication_workload[r]);
+	}
+
+	free(values);
+	free(stats);
+	free(streams);
+	free(simulation_params_of);
+	free(simulation_params);
+	free(replication_workload);
+	free(replication_stream);
+}
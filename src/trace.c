@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////
+// Running state trace implementation using a buffer,
+// that is written to the file in batches
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+#include "common_types.h"
+
+#define TRACE_MAX_RECORD_SIZE 128	// longest formatted record, so there's always space for the next one
+
+struct trace {
+	FILE* fp;			// file opened once, for the whole simulation
+	TraceFormat format;
+	char* buffer;		// records not written to the file yet
+	int buffer_size;	// total allocated memory of the buffer
+	int used;			// bytes of the buffer used
+	int flush_every;	// records between two flushes, 0 if we flush only when the buffer is full
+	int records;		// records since the last flush
+
+	// binary format only: the last RUNNING record, which can still cover more slots, isn't in the buffer yet
+	TraceRecord pending;
+	bool has_pending;
+};
+
+// Writes the buffer to the file
+static void trace_write_buffer(Trace* trace) {
+	if (trace->used == 0)
+		return;
+
+	if (fwrite(trace->buffer, 1, trace->used, trace->fp) != (size_t)trace->used)
+		error_exit("trace: fwrite failed");
+	trace->used = 0;
+}
+
+// Binary format: copies the record to the buffer
+static void trace_buffer_record(Trace* trace, TraceRecord* record) {
+	memcpy(trace->buffer + trace->used, record, sizeof(*record));
+	trace->used += sizeof(*record);
+	if (trace->buffer_size - trace->used < TRACE_MAX_RECORD_SIZE)
+		trace_write_buffer(trace);
+}
+
+// Binary format: the pending record can't cover more slots, so it goes to the buffer
+static void trace_buffer_pending(Trace* trace) {
+	if (trace->has_pending) {
+		trace_buffer_record(trace, &trace->pending);
+		trace->has_pending = false;
+	}
+}
+
+Trace* trace_open(const char* filename, TraceFormat format, int buffer_size, int flush_every) {
+	FILE* fp = fopen(filename, "w");
+	if (fp == NULL)
+		return NULL;
+	setvbuf(fp, NULL, _IONBF, 0);	// we do the buffering, so no need for the stdio buffer too
+
+	Trace* trace = malloc(sizeof(*trace));
+	trace->fp = fp;
+	trace->format = format;
+	trace->buffer_size = buffer_size < TRACE_MIN_BUFFER_SIZE ? TRACE_MIN_BUFFER_SIZE : buffer_size;
+	trace->buffer = malloc(trace->buffer_size);
+	trace->used = 0;
+	trace->flush_every = flush_every;
+	trace->records = 0;
+	trace->has_pending = false;
+
+	if (format == TRACE_BINARY) {
+		TraceHeader header = { .version = TRACE_VERSION, .record_size = sizeof(TraceRecord) };
+		memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+		memcpy(trace->buffer, &header, sizeof(header));
+		trace->used = sizeof(header);
+	}
+	return trace;
+}
+
+void trace_flush(Trace* trace) {
+	if (trace == NULL)
+		return;
+
+	trace_buffer_pending(trace);
+	trace_write_buffer(trace);
+	trace->records = 0;
+}
+
+// Called after every record is added to the buffer, flushes it according to the flush policy
+static void trace_record_added(Trace* trace) {
+	trace->records++;
+	if ((trace->buffer_size - trace->used < TRACE_MAX_RECORD_SIZE) || (trace->flush_every > 0 && trace->records >= trace->flush_every))
+		trace_flush(trace);
+}
+
+void trace_running(Trace* trace, int slot, int pid, int service_time, int semid) {
+	if (trace == NULL)
+		return;
+
+	if (trace->format == TRACE_TEXT) {
+		trace->used += snprintf(trace->buffer + trace->used, trace->buffer_size - trace->used,
+								"Running now Process with PID: %d, Current Service Time: %d\n", pid, service_time);
+	}
+	else {
+		TraceRecord* pending = &trace->pending;
+
+		// the process continues from the slot after the ones of the pending record, so the record just covers one more slot
+		if (trace->has_pending && pending->pid == pid && pending->semid == semid && pending->count < TRACE_MAX_COUNT
+			&& pending->slot + pending->count == (uint32_t)slot && pending->service_time + pending->count == (uint32_t)service_time) {
+			pending->count++;
+		}
+		else {
+			trace_buffer_pending(trace);
+			*pending = (TraceRecord){ .slot = slot, .pid = pid, .service_time = service_time, .semid = semid,
+									  .event = TRACE_EVENT_RUNNING, .count = 1 };
+			trace->has_pending = true;
+		}
+	}
+	trace_record_added(trace);
+}
+
+void trace_finishing(Trace* trace, int slot, int pid) {
+	if (trace == NULL)
+		return;
+
+	if (trace->format == TRACE_TEXT) {
+		trace->used += snprintf(trace->buffer + trace->used, trace->buffer_size - trace->used, "Finishing now Process with PID: %d\n", pid);
+	}
+	else {
+		TraceRecord record = { .slot = slot, .pid = pid, .service_time = 0, .semid = -1, .event = TRACE_EVENT_FINISHING, .count = 1 };
+		trace_buffer_pending(trace);
+		trace_buffer_record(trace, &record);
+	}
+	trace_record_added(trace);
+}
+
+void trace_close(Trace* trace) {
+	if (trace == NULL)
+		return;
+
+	trace_flush(trace);
+	fclose(trace->fp);
+	free(trace->buffer);
+	free(trace);
+}
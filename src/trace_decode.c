@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////
+// Decoder of the binary running state trace
+// Turns it back into the text format of running_state.log, or into CSV
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+#include "common_types.h"
+
+#define DECODE_BATCH 4096	// records read from the file at once
+
+// prints every slot covered by the record, in the text format of running_state.log
+static void print_text(FILE* out, TraceRecord* record) {
+	if (record->event == TRACE_EVENT_FINISHING) {
+		fprintf(out, "Finishing now Process with PID: %d\n", record->pid);
+		return;
+	}
+	for (uint32_t i = 0; i < record->count; i++)
+		fprintf(out, "Running now Process with PID: %d, Current Service Time: %u\n", record->pid, record->service_time + i);
+}
+
+// prints every slot covered by the record as a CSV row
+static void print_csv(FILE* out, TraceRecord* record) {
+	const char* event = record->event == TRACE_EVENT_FINISHING ? "finishing" : "running";
+	for (uint32_t i = 0; i < record->count; i++)
+		fprintf(out, "%u,%d,%s,%u,%d\n", record->slot + i, record->pid, event,
+				record->event == TRACE_EVENT_FINISHING ? 0 : record->service_time + i, record->semid);
+}
+
+int main(int argc, char* argv[]) {
+	void (*print)(FILE*, TraceRecord*) = print_text;
+
+	// Correct number of arguments needed
+	if ((argc != 2 && argc != 3) || (argc == 3 && strcmp(argv[1], "--csv") != 0)) {
+		fprintf(stderr, "Error! Correct Usage: ./trace_decode [--csv] <binary trace file>\n");
+		exit(EXIT_FAILURE);
+	}
+	if (argc == 3)
+		print = print_csv;
+
+	FILE* in = fopen(argv[argc - 1], "rb");
+	if (in == NULL)
+		error_exit("trace_decode: fopen failed");
+
+	// checking that the file is a binary trace, written by the same version
+	TraceHeader header;
+	if (fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0
+		|| header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord)) {
+		fprintf(stderr, "Error! %s is not a binary running state trace of version %d\n", argv[argc - 1], TRACE_VERSION);
+		fclose(in);
+		exit(EXIT_FAILURE);
+	}
+
+	static char out_buffer[1 << 20];
+	setvbuf(stdout, out_buffer, _IOFBF, sizeof(out_buffer));
+	if (print == print_csv)
+		printf("slot,pid,event,service_time,semid\n");
+
+	TraceRecord* records = malloc(DECODE_BATCH * sizeof(*records));
+	size_t read;
+	while ((read = fread(records, sizeof(*records), DECODE_BATCH, in)) > 0)
+		for (size_t i = 0; i < read; i++)
+			print(stdout, &records[i]);
+
+	free(records);
+	fclose(in);
+	return 0;
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////
+// Batch variates implementation, with a branch free log
+// so that the exponential kernel is vectorized
+///////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <string.h>
+#include "variates.h"
+
+// Coefficients of the polynomial approximation of log(1+f) of fdlibm(e_log.c)
+#define LN2_HI	6.93147180369123816490e-01
+#define LN2_LO	1.90821492927058770002e-10
+#define LG1		6.666666666666735130e-01
+#define LG2		3.999999999940941908e-01
+#define LG3		2.857142874366239149e-01
+#define LG4		2.222219843214978396e-01
+#define LG5		1.818357216161805012e-01
+#define LG6		1.531383769920937332e-01
+#define LG7		1.479819860511658591e-01
+
+// log(x) for a normal x > 0, the algorithm of fdlibm without its branches for the special cases,
+// so that a loop calling it is vectorized(gcc does it at -O3, so the Makefile compiles this file with VARIATES_CFLAGS).
+// x = 2^k * (1+f), with 1+f in [sqrt(2)/2, sqrt(2))
+static inline double batch_log(double x) {
+	uint64_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+
+	uint32_t hx = bits >> 32;
+	int k = (int)(hx >> 20) - 1023;
+	hx &= 0x000fffff;
+	uint32_t i = (hx + 0x95f64) & 0x100000;		// the mantissa is >= sqrt(2), so it's halved and k is increased
+	hx |= i ^ 0x3ff00000;
+	k += i >> 20;
+	bits = ((uint64_t)hx << 32) | (bits & 0xffffffff);
+	memcpy(&x, &bits, sizeof(x));
+
+	double f = x - 1.0;
+	double s = f / (2.0 + f);
+	double z = s * s;
+	double w = z * z;
+	double t1 = w * (LG2 + w * (LG4 + w * LG6));
+	double t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+	double R = t2 + t1;
+	double dk = k;
+	return dk * LN2_HI - ((s * (f - R) - dk * LN2_LO) - f);
+}
+
+void uniform_batch(Rng* rng, double* u, int n) {
+	for (int i = 0; i < n; i++)
+		u[i] = rng_double(rng);
+}
+
+void exponential_batch(const double* restrict u, double* restrict out, int n, double lambda) {
+	for (int i = 0; i < n; i++)
+		out[i] = -batch_log(1.0 - u[i]) / lambda;
+}
+
+void uniform_int_batch(const double* restrict u, int* restrict out, int n, int low, int high) {
+	int range = high - low + 1;
+	for (int i = 0; i < n; i++)
+		out[i] = (u[i] * range) + low;
+}
+
+double prefix_sum(const double* in, double* out, int n, double start) {
+	for (int i = 0; i < n; i++) {
+		start += in[i];
+		out[i] = start;
+	}
+	return start;
+}
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////
+// Workload file implementation, using mmap, so that the
+// processes are parsed in place, without reading the file
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "workload.h"
+#include "common_types.h"
+
+struct workload {
+	const char* filename;
+	WorkloadFormat format;
+	char* map;				// the whole file, NULL if it's empty
+	size_t size;			// bytes of the file
+	const WorkloadRecord* records;	// binary format only: the records, in the map
+	size_t count;
+	WorkloadRecord* memory;	// the records of a workload created in memory, instead of the map
+};
+
+// Exits with an error message for the process at pos of the workload
+static void workload_error(Workload* workload, size_t pos, const char* msg) {
+	if (workload->format == WORKLOAD_BINARY) {
+		fprintf(stderr, "Error! %s: record %zu: %s\n", workload->filename, pos, msg);
+	}
+	else {
+		size_t line = 1;	// the line number is counted only here, so that reading a line doesn't have to
+		for (size_t i = 0; i < pos; i++)
+			line += workload->map[i] == '\n';
+		fprintf(stderr, "Error! %s: line %zu: %s\n", workload->filename, line, msg);
+	}
+	exit(EXIT_FAILURE);
+}
+
+Workload* workload_open(const char* filename) {
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1)
+		return NULL;
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return NULL;
+	}
+
+	Workload* workload = malloc(sizeof(*workload));
+	workload->filename = filename;
+	workload->format = WORKLOAD_CSV;
+	workload->size = st.st_size;
+	workload->map = NULL;
+	workload->records = NULL;
+	workload->count = 0;
+	workload->memory = NULL;
+
+	// the file is read once from its start to its end, so the kernel can read ahead
+	if (workload->size != 0) {
+		workload->map = mmap(NULL, workload->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (workload->map == MAP_FAILED) {
+			close(fd);
+			free(workload);
+			return NULL;
+		}
+		madvise(workload->map, workload->size, MADV_SEQUENTIAL);
+	}
+	close(fd);	// the map stays valid
+
+	// checking that a binary workload is written by the same version, and that it has all its records
+	if (workload->size >= sizeof(WorkloadHeader) && memcmp(workload->map, WORKLOAD_MAGIC, 4) == 0) {
+		WorkloadHeader header;
+		memcpy(&header, workload->map, sizeof(header));
+		workload->format = WORKLOAD_BINARY;
+		if (header.version != WORKLOAD_VERSION || header.record_size != sizeof(WorkloadRecord)
+			|| (workload->size - sizeof(header)) / sizeof(WorkloadRecord) != header.count
+			|| (workload->size - sizeof(header)) % sizeof(WorkloadRecord) != 0) {
+			fprintf(stderr, "Error! %s is not a binary workload of version %d\n", filename, WORKLOAD_VERSION);
+			exit(EXIT_FAILURE);
+		}
+		workload->records = (const WorkloadRecord*)(workload->map + sizeof(header));	// mmap is page aligned, so the records are aligned too
+		workload->count = header.count;
+	}
+	return workload;
+}
+
+Workload* workload_create(WorkloadRecord* records, size_t count) {
+	Workload* workload = malloc(sizeof(*workload));
+	workload->filename = "memory";
+	workload->format = WORKLOAD_BINARY;
+	workload->map = NULL;
+	workload->size = 0;
+	workload->records = records;
+	workload->count = count;
+	workload->memory = records;
+	return workload;
+}
+
+WorkloadFormat workload_format(Workload* workload) { return workload->format; }
+
+// Checks the values of the process at pos
+static void workload_check(Workload* workload, size_t pos, WorkloadRecord* record) {
+	if (record->priority < 1 || record->priority > 7)
+		workload_error(workload, pos, "priority is not in 1..7");
+	if (!(record->arrival_time >= 0) || !(record->lifetime >= 0))	// NaNs too
+		workload_error(workload, pos, "negative arrival_time or lifetime");
+	// a process with no CS would be done with it without ever taking a semaphore, and the generator never gives one
+	if (!(record->cs_time > 0))
+		workload_error(workload, pos, "cs_time is not positive");
+}
+
+// Parses a plain decimal number, like 12.375, followed by a ',', without strtod, which is the most of the parsing time.
+// Its digits without the point are an integer m <= 2^53 and it equals m / 10^d, with d <= 22, where both are exact doubles,
+// so their quotient is rounded correctly, exactly like strtod(Clinger's fast path). Returns false for any other number
+static bool parse_decimal(const char* field, double* value, char** end) {
+	static const double powers_of_10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+										   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	const char* c = field;
+	uint64_t m = 0;
+	int digits = 0, decimals = -1;	// digits after the point, -1 till the point
+
+	for (; isdigit((unsigned char)*c) || (*c == '.' && decimals == -1); c++) {
+		if (*c == '.') {
+			decimals = 0;
+			continue;
+		}
+		if (++digits > 16)		// m could pass 2^53
+			return false;
+		m = m * 10 + (*c - '0');
+		decimals += decimals != -1;
+	}
+	if (digits == 0 || *c != ',' || m > ((uint64_t)1 << 53))
+		return false;
+
+	*value = decimals > 0 ? (double)m / powers_of_10[decimals] : (double)m;
+	*end = (char*)c;
+	return true;
+}
+
+// Parses the next field of a CSV line, a number followed by a ','
+static bool parse_field(char** field, double* value) {
+	char* end;
+	if (isspace((unsigned char)**field))	// strtod would skip it, even if the field is empty
+		return false;
+	if (!parse_decimal(*field, value, &end))
+		*value = strtod(*field, &end);
+	if (end == *field || *end != ',')
+		return false;
+	*field = end + 1;
+	return true;
+}
+
+// CSV format: the line starting at *pos. Only that line is copied out of the map, since strtod needs
+// a terminated string, and the map isn't(its last line can end exactly at the end of the file)
+static bool workload_read_csv(Workload* workload, size_t* pos, WorkloadRecord* record) {
+	while (*pos < workload->size) {
+		const char* start = workload->map + *pos;
+		const char* newline = memchr(start, '\n', workload->size - *pos);
+		size_t length = newline != NULL ? (size_t)(newline - start) : workload->size - *pos;
+		size_t line_pos = *pos;
+		*pos += length + (newline != NULL);
+
+		if (length != 0 && start[length - 1] == '\r')	// CRLF line endings
+			length--;
+
+		// empty lines, comments, and the header
+		if (length == 0 || start[0] == '#' || (line_pos == 0 && !isdigit((unsigned char)start[0]) && strchr("+-.", start[0]) == NULL))
+			continue;
+
+		if (length >= WORKLOAD_MAX_LINE)
+			workload_error(workload, line_pos, "line too long");
+		char line[WORKLOAD_MAX_LINE + 1];
+		memcpy(line, start, length);
+		line[length] = ',';		// every field is followed by a ','
+		line[length + 1] = '\0';
+
+		char* field = line;
+		double priority;
+		if (!parse_field(&field, &record->arrival_time) || !parse_field(&field, &record->lifetime)
+			|| !parse_field(&field, &priority) || !parse_field(&field, &record->cs_time) || *field != '\0')
+			workload_error(workload, line_pos, "expected " WORKLOAD_CSV_HEADER);
+		if (!(priority >= 1 && priority <= 7) || priority != (int32_t)priority)
+			workload_error(workload, line_pos, "priority is not in 1..7");
+		record->priority = priority;
+		record->reserved = 0;
+
+		workload_check(workload, line_pos, record);
+		return true;
+	}
+	return false;
+}
+
+bool workload_read(Workload* workload, size_t* pos, WorkloadRecord* record) {
+	if (workload->format == WORKLOAD_CSV)
+		return workload_read_csv(workload, pos, record);
+
+	if (*pos == workload->count)
+		return false;
+	*record = workload->records[*pos];
+	workload_check(workload, *pos, record);
+	(*pos)++;
+	return true;
+}
+
+void workload_close(Workload* workload) {
+	if (workload->map != NULL)
+		munmap(workload->map, workload->size);
+	free(workload->memory);
+	free(workload);
+}
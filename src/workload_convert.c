@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////
+// Converter of workload files
+// Turns a CSV workload into the binary format, or back
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "workload.h"
+#include "common_types.h"
+
+#define CONVERT_BATCH 4096	// records written to the file at once
+
+int main(int argc, char* argv[]) {
+	bool to_csv = false;
+
+	// Correct number of arguments needed
+	if ((argc != 3 && argc != 4) || (argc == 4 && strcmp(argv[1], "--csv") != 0)) {
+		fprintf(stderr, "Error! Correct Usage: ./workload_convert [--csv] <input workload> <output workload>\n");
+		exit(EXIT_FAILURE);
+	}
+	if (argc == 4)
+		to_csv = true;
+
+	Workload* workload = workload_open(argv[argc - 2]);
+	if (workload == NULL)
+		error_exit("workload_convert: open failed");
+	FILE* out = fopen(argv[argc - 1], "wb");
+	if (out == NULL)
+		error_exit("workload_convert: fopen failed");
+
+	WorkloadRecord* records = malloc(CONVERT_BATCH * sizeof(*records));
+	WorkloadHeader header = { .version = WORKLOAD_VERSION, .record_size = sizeof(WorkloadRecord), .count = 0 };
+	memcpy(header.magic, WORKLOAD_MAGIC, sizeof(header.magic));
+
+	// the count is known only at the end, so the header is written again then
+	if (to_csv)
+		fprintf(out, "%s\n", WORKLOAD_CSV_HEADER);
+	else
+		fwrite(&header, sizeof(header), 1, out);
+
+	size_t pos = 0;
+	int n = 0;
+	do {
+		n = 0;
+		while (n < CONVERT_BATCH && workload_read(workload, &pos, &records[n]))
+			n++;
+
+		// %.17g, so that the CSV gives back exactly the same doubles
+		if (to_csv) {
+			for (int i = 0; i < n; i++)
+				fprintf(out, "%.17g,%.17g,%d,%.17g\n", records[i].arrival_time, records[i].lifetime, records[i].priority, records[i].cs_time);
+		}
+		else if (fwrite(records, sizeof(*records), n, out) != (size_t)n) {
+			error_exit("workload_convert: fwrite failed");
+		}
+		header.count += n;
+	} while (n == CONVERT_BATCH);
+
+	if (!to_csv && (fseek(out, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, out) != 1))
+		error_exit("workload_convert: fwrite failed");
+	if (fclose(out) != 0)
+		error_exit("workload_convert: fclose failed");
+
+	free(records);
+	workload_close(workload);
+	return 0;
+}
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////
+// Test of the buckets of the Aggregate: every value, whole
+// or fractional, has to be in the [low, high) of its bucket,
+// and its percentiles between it and the high bound
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "aggregate.h"
+
+static void fail(const char* check, double value) {
+	fprintf(stderr, "Error! %s failed for value %g\n", check, value);
+	exit(EXIT_FAILURE);
+}
+
+// Adds value alone to an aggregate, and checks the bucket it went to and the percentiles
+static void check_value(double value) {
+	Aggregate aggregate;
+	aggregate_init(&aggregate);
+	aggregate_add(&aggregate, value);
+
+	int bucket = -1;
+	for (int i = 0; i < AGGREGATE_BUCKETS; i++)
+		if (aggregate.buckets[i] != 0)
+			bucket = i;
+	if (bucket == -1)
+		fail("bucket", value);
+
+	// the bounds as they are printed(%.0f) too
+	double low = aggregate_bucket_low(bucket), high = aggregate_bucket_high(bucket);
+	char printed_low[32], printed_high[32];
+	snprintf(printed_low, sizeof(printed_low), "%.0f", low);
+	snprintf(printed_high, sizeof(printed_high), "%.0f", high);
+	if (!(low <= value && value < high) || !(atof(printed_low) <= value && value < atof(printed_high)))
+		fail("[low, high)", value);
+
+	// a single value, so every percentile is clamped to it
+	if (aggregate_percentile(&aggregate, 50) != value || aggregate_percentile(&aggregate, 99.9) != value)
+		fail("percentile", value);
+}
+
+// Values spread over a few buckets: the percentile is the high bound of the bucket, or the max
+static void check_percentiles(void) {
+	Aggregate aggregate;
+	aggregate_init(&aggregate);
+	double values[] = { 0.5, 3.25, 11.28, 18.35, 33.5, 40.75 };
+	int n = sizeof(values) / sizeof(values[0]);
+	for (int i = 0; i < n; i++)
+		aggregate_add(&aggregate, values[i]);
+
+	if (aggregate_percentile(&aggregate, 50) != 12)		// 11.28 is the 3rd of 6, in [11, 12)
+		fail("p50", 11.28);
+	if (aggregate_percentile(&aggregate, 80) != 34)		// 33.5 is the 5th, in [32, 34)
+		fail("p80", 33.5);
+	if (aggregate_percentile(&aggregate, 100) != 40.75)	// [40, 42) is clamped to the max
+		fail("p100", 40.75);
+}
+
+int main(void) {
+	double values[] = { 0, 0.25, 0.999, 1, 11.28, 12, 18.35, 31.5, 31.999, 32, 33, 33.5, 35.9, 100.01, 1000.5, 65535.75, 1e9 + 0.5 };
+	int n = sizeof(values) / sizeof(values[0]);
+	for (int i = 0; i < n; i++)
+		check_value(values[i]);
+	check_percentiles();
+
+	printf("aggregate: %d values in their buckets, percentiles passed\n", n);
+	return 0;
+}
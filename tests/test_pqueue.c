@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////
+// Randomized stress test of the PriorityQueue: random inserts,
+// removals and key updates, checking the heap invariant after
+// every one of them, and every max against a reference array
+///////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ADTPriorityQueue.h"
+
+#define MAX_ITEMS 2000	// items in the pqueue at the same time, at most
+#define KEYS 100		// keys are 0..KEYS-1, so that there are many equal ones
+
+typedef struct item {
+	int key;
+	int id;		// ties are broken by id, so that the max is unique and the reference agrees with the pqueue
+	PriorityQueueNode* node;
+} Item;
+
+static int item_compare(void* a, void* b) {
+	Item* ia = a, *ib = b;
+	if (ia->key != ib->key)
+		return ia->key < ib->key ? -1 : 1;
+	return ia->id < ib->id ? -1 : ia->id > ib->id;
+}
+
+// The reference: the items in the pqueue, in no order. Its max is found by a scan
+static Item* items[MAX_ITEMS];
+static int count;
+
+static int reference_max(void) {
+	int max = 0;
+	for (int i = 1; i < count; i++)
+		if (item_compare(items[i], items[max]) > 0)
+			max = i;
+	return max;
+}
+
+static void reference_remove(int i) { items[i] = items[--count]; }
+
+static void fail(const char* operation, unsigned seed, int step) {
+	fprintf(stderr, "Error! %s failed, seed %u, step %d\n", operation, seed, step);
+	exit(EXIT_FAILURE);
+}
+
+// Runs steps random operations on a pqueue, starting from a heapified one
+static void stress(unsigned seed, int steps) {
+	srand(seed);
+	int next_id = 0;
+
+	// half of the items at the start are heapified at once
+	Vector* values = vector_create(0, NULL);
+	for (count = 0; count < MAX_ITEMS / 2; count++) {
+		items[count] = malloc(sizeof(Item));
+		*items[count] = (Item){ .key = rand() % KEYS, .id = next_id++ };
+		vector_insert_last(values, items[count]);
+	}
+	PriorityQueue* pq = pqueue_create(item_compare, NULL, values, 0);
+	vector_destroy(values);
+	if (!pqueue_check_invariant(pq))
+		fail("heapify", seed, 0);
+
+	// the nodes of the heapified items are found through the vector of the pqueue
+	Vector* nodes = pqueue_get_vector(pq);
+	for (int i = 0; i < vector_size(nodes); i++) {
+		PriorityQueueNode* node = vector_get_at(nodes, i);
+		((Item*)pqueue_node_value(node))->node = node;
+	}
+
+	for (int step = 1; step <= steps; step++) {
+		const char* operation;
+		int op = rand() % 5;
+		if (count == 0)
+			op = 0;
+		else if (count == MAX_ITEMS)
+			op = 1 + rand() % 4;
+
+		if (op == 0) {
+			operation = "insert";
+			Item* item = malloc(sizeof(*item));
+			*item = (Item){ .key = rand() % KEYS, .id = next_id++ };
+			item->node = pqueue_insert(pq, item);
+			items[count++] = item;
+		}
+		else if (op == 1) {
+			operation = "remove_max";
+			int max = reference_max();
+			if (pqueue_remove_max(pq) != items[max])
+				fail(operation, seed, step);
+			free(items[max]);
+			reference_remove(max);
+		}
+		else if (op == 2) {
+			operation = "remove_node";
+			int i = rand() % count;
+			pqueue_remove_node(pq, items[i]->node);
+			free(items[i]);
+			reference_remove(i);
+		}
+		else if (op == 3) {
+			operation = "increase_key";
+			Item* item = items[rand() % count];
+			item->key += rand() % KEYS;
+			pqueue_increase_key(pq, item->node);
+		}
+		else {
+			operation = "decrease_key";
+			Item* item = items[rand() % count];
+			item->key -= rand() % KEYS;
+			pqueue_decrease_key(pq, item->node);
+		}
+
+		if (!pqueue_check_invariant(pq) || pqueue_size(pq) != count)
+			fail(operation, seed, step);
+		if (count != 0 && pqueue_max(pq) != items[reference_max()])
+			fail(operation, seed, step);
+	}
+
+	// what is left comes out in the order of the reference
+	while (count != 0) {
+		int max = reference_max();
+		if (pqueue_remove_max(pq) != items[max])
+			fail("remove_max", seed, steps);
+		free(items[max]);
+		reference_remove(max);
+	}
+	pqueue_destroy(pq);
+}
+
+int main(int argc, char* argv[]) {
+	int seeds = argc > 1 ? atoi(argv[1]) : 20;
+	int steps = argc > 2 ? atoi(argv[2]) : 20000;
+
+	for (int seed = 1; seed <= seeds; seed++)
+		stress(seed, steps);
+	printf("pqueue: %d seeds of %d random operations passed\n", seeds, steps);
+	return 0;
+}